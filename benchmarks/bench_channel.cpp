@@ -0,0 +1,87 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <optional>
+#include <thread>
+#include "channel.hpp"
+#include "spsc_ringbuffer.hpp"
+
+// Three stage pipeline: generate, square, sum. Coroutines on one executor
+// against one thread per stage connected by SpscRingbuffer.
+constexpr int pipeline_items = 100000;
+
+static Task generate(Channel<int, 64> & out) {
+    for(int i = 0; i < pipeline_items; ++i) co_await out.push(i);
+    out.close();
+}
+
+static Task square(Channel<int, 64> & in, Channel<long, 64> & out) {
+    while(std::optional<int> value = co_await in.pop()) co_await out.push(long(*value) * *value);
+    out.close();
+}
+
+static Task sum(Channel<long, 64> & in, long & total) {
+    while(std::optional<long> value = co_await in.pop()) total += *value;
+}
+
+static void BM_pipeline_coroutines(benchmark::State & state) {
+    for(auto _ : state) {
+        Executor executor;
+        Channel<int, 64> numbers(executor);
+        Channel<long, 64> squares(executor);
+        long total = 0;
+        executor.spawn(sum(squares, total));
+        executor.spawn(square(numbers, squares));
+        executor.spawn(generate(numbers));
+        executor.run();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * pipeline_items);
+}
+BENCHMARK(BM_pipeline_coroutines);
+
+static void BM_pipeline_threads(benchmark::State & state) {
+    for(auto _ : state) {
+        auto numbers = std::make_unique<SpscRingbuffer<int, 64>>();
+        auto squares = std::make_unique<SpscRingbuffer<long, 64>>();
+        std::thread generator([&] {
+            for(int i = 0; i < pipeline_items; ++i) {
+                while( ! numbers->try_push(i) ) std::this_thread::yield();
+            }
+        });
+        std::thread squarer([&] {
+            int value;
+            for(int i = 0; i < pipeline_items; ++i) {
+                while( ! numbers->try_pop(value) ) std::this_thread::yield();
+                while( ! squares->try_push(long(value) * value) ) std::this_thread::yield();
+            }
+        });
+        long total = 0, value;
+        for(int i = 0; i < pipeline_items; ++i) {
+            while( ! squares->try_pop(value) ) std::this_thread::yield();
+            total += value;
+        }
+        generator.join();
+        squarer.join();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * pipeline_items);
+}
+BENCHMARK(BM_pipeline_threads)->UseRealTime();
@@ -0,0 +1,116 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <vector>
+#define USE_ITERATORS
+#include "intrusive_list.hpp"
+#include "llist.hpp"
+
+namespace {
+
+struct Item : IntrusiveHook<> {
+    long value;
+    explicit Item(long _value) : value(_value) {}
+};
+
+}
+
+// Objects live in a vector either way, the intrusive list links them in place
+// while LList allocates a node holding a copy.
+static void BM_intrusive_push_pop(benchmark::State & state) {
+    std::vector<Item> items;
+    for(long i = 0; i < state.range(0); ++i) items.emplace_back(i);
+    IntrusiveList<Item> list;
+    for(auto _ : state) {
+        for(Item & item : items) list.push_back(item);
+        while( ! list.empty() ) list.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_intrusive_push_pop)->Arg(16)->Arg(1024);
+
+static void BM_llist_push_pop(benchmark::State & state) {
+    std::vector<Item> items;
+    for(long i = 0; i < state.range(0); ++i) items.emplace_back(i);
+    LList<Item> list;
+    for(auto _ : state) {
+        for(const Item & item : items) list.push_back(item);
+        while( ! list.empty() ) list.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_llist_push_pop)->Arg(16)->Arg(1024);
+
+// Erasing arbitrary members, e.g. closing connections. The intrusive list
+// unlinks through the object, LList has to find the node first.
+static void BM_intrusive_erase_every_other(benchmark::State & state) {
+    std::vector<Item> items;
+    for(long i = 0; i < state.range(0); ++i) items.emplace_back(i);
+    IntrusiveList<Item> list;
+    for(auto _ : state) {
+        for(Item & item : items) list.push_back(item);
+        for(size_t i = 0; i < items.size(); i += 2) items[i].unlink();
+        benchmark::DoNotOptimize(list.front().value);
+        list.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_intrusive_erase_every_other)->Arg(16)->Arg(1024);
+
+static void BM_llist_erase_every_other(benchmark::State & state) {
+    LList<long> list;
+    for(auto _ : state) {
+        for(long i = 0; i < state.range(0); ++i) list.push_back(i);
+        // LList can only drop its ends, so rotate kept elements to the back.
+        for(long i = 0; i < state.range(0); ++i) {
+            if(i % 2) list.push_back(list.front());
+            list.pop_front();
+        }
+        benchmark::DoNotOptimize(list.front());
+        list.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_llist_erase_every_other)->Arg(16)->Arg(1024);
+
+static void BM_intrusive_iterate(benchmark::State & state) {
+    std::vector<Item> items;
+    for(long i = 0; i < state.range(0); ++i) items.emplace_back(i);
+    IntrusiveList<Item> list;
+    for(Item & item : items) list.push_back(item);
+    for(auto _ : state) {
+        long sum{0};
+        for(const Item & item : list) sum += item.value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_intrusive_iterate)->Arg(1024)->Arg(1 << 16);
+
+static void BM_llist_iterate(benchmark::State & state) {
+    LList<Item> list;
+    for(long i = 0; i < state.range(0); ++i) list.push_back(Item(i));
+    for(auto _ : state) {
+        long sum{0};
+        for(const Item & item : list) sum += item.value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_llist_iterate)->Arg(1024)->Arg(1 << 16);
@@ -0,0 +1,77 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "llist.hpp"
+#include "mpmc_list_queue.hpp"
+#include "mpsc_list_queue.hpp"
+
+// state.range(0) producer threads push per_producer elements each while the
+// benchmark thread consumes all of them, as in a work queue feeding one stage.
+
+static constexpr int per_producer = 20000;
+
+namespace {
+
+class MutexLList {
+    std::mutex m_mutex;
+    LList<int> m_list;
+public:
+    void push(int item) {
+        std::lock_guard lock(m_mutex);
+        m_list.push_back(item);
+    }
+    bool try_pop(int & item) {
+        std::lock_guard lock(m_mutex);
+        if(m_list.empty()) return false;
+        item = m_list.front();
+        m_list.pop_front();
+        return true;
+    }
+};
+
+}
+
+template<class Queue>
+static void BM_producers(benchmark::State & state) {
+    const int producers = static_cast<int>(state.range(0));
+    for(auto _ : state) {
+        Queue queue;
+        std::vector<std::thread> threads;
+        for(int p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue] {
+                for(int i = 0; i < per_producer; ++i) queue.push(i);
+            });
+        }
+        int item{0};
+        long sum{0};
+        for(int received = 0; received < producers * per_producer; ) {
+            if(queue.try_pop(item)) { sum += item; received++; }
+            else std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(sum);
+        for(auto & thread : threads) thread.join();
+    }
+    state.SetItemsProcessed(state.iterations() * producers * per_producer);
+}
+BENCHMARK(BM_producers<MpscListQueue<int>>)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_producers<MpmcListQueue<int>>)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_producers<MutexLList>)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,90 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <list>
+#define USE_ITERATORS
+#include "llist.hpp"
+#include "node_pool.hpp"
+#include "unrolled_llist.hpp"
+
+template<class List>
+static void BM_push_pop(benchmark::State & state) {
+    List list;
+    const int count = static_cast<int>(state.range(0));
+    for(auto _ : state) {
+        for(int i = 0; i < count; ++i) list.push_back(i);
+        for(int i = 0; i < count; ++i) list.pop_front();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_push_pop<LList<int>>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_push_pop<LList<int, SlabAllocator<int>>>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_push_pop<UnrolledLList<int>>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_push_pop<std::list<int>>)->Arg(16)->Arg(1024);
+BENCHMARK(BM_push_pop<std::deque<int>>)->Arg(16)->Arg(1024);
+
+template<class List>
+static void BM_iterate(benchmark::State & state) {
+    List list;
+    const int count = static_cast<int>(state.range(0));
+    for(int i = 0; i < count; ++i) list.push_back(i);
+    for(auto _ : state) {
+        long sum{0};
+        for(auto value : list) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_iterate<LList<int>>)->Arg(1024)->Arg(1 << 16);
+BENCHMARK(BM_iterate<LList<int, SlabAllocator<int>>>)->Arg(1024)->Arg(1 << 16);
+BENCHMARK(BM_iterate<UnrolledLList<int>>)->Arg(1024)->Arg(1 << 16);
+BENCHMARK(BM_iterate<UnrolledLList<int, 64>>)->Arg(1024)->Arg(1 << 16);
+BENCHMARK(BM_iterate<std::list<int>>)->Arg(1024)->Arg(1 << 16);
+BENCHMARK(BM_iterate<std::deque<int>>)->Arg(1024)->Arg(1 << 16);
+
+// Counts bytes requested from the heap, malloc's own overhead is not included.
+static size_t allocated_bytes{0};
+
+template<class T>
+struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template<class U> CountingAllocator(const CountingAllocator<U> &) {}
+    T * allocate(size_t n) { allocated_bytes += n * sizeof(T); return std::allocator<T>().allocate(n); }
+    void deallocate(T * p, size_t n) { allocated_bytes -= n * sizeof(T); std::allocator<T>().deallocate(p, n); }
+    bool operator==(const CountingAllocator &) const { return true; }
+};
+
+template<class List>
+static void BM_memory_per_element(benchmark::State & state) {
+    const int count = static_cast<int>(state.range(0));
+    size_t bytes{0};
+    for(auto _ : state) {
+        const size_t before = allocated_bytes;
+        List list;
+        for(int i = 0; i < count; ++i) list.push_back(i);
+        bytes = allocated_bytes - before;
+    }
+    state.counters["bytes_per_element"] = static_cast<double>(bytes) / count;
+}
+BENCHMARK(BM_memory_per_element<LList<int, CountingAllocator<int>>>)->Arg(1 << 16);
+BENCHMARK(BM_memory_per_element<UnrolledLList<int, 16, CountingAllocator<int>>>)->Arg(1 << 16);
+BENCHMARK(BM_memory_per_element<UnrolledLList<int, 64, CountingAllocator<int>>>)->Arg(1 << 16);
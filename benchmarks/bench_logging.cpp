@@ -0,0 +1,90 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+#define LOGGING_ASYNC
+#define LOGGING_DEFERRED
+#define LOGGING_MIN_LEVEL INFO
+#include "logging/logging.hpp"
+
+// Text written while measuring goes to /dev/null, benchmark results keep stdout.
+class DiscardStdout {
+    int saved;
+public:
+    DiscardStdout() {
+        fflush(stdout);
+        saved = dup(STDOUT_FILENO);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+    ~DiscardStdout() {
+        fflush(stdout);
+        dup2(saved, STDOUT_FILENO);
+        close(saved);
+    }
+};
+
+static void BM_log_enabled(benchmark::State & state) {
+    DiscardStdout discard;
+    Logging::SetLoggingLevel(Logging::Level::INFO);
+    int i = 0;
+    for(auto _ : state) Logging::Info("sample %d value %f", i++, 0.5);
+}
+BENCHMARK(BM_log_enabled);
+
+static void BM_log_filtered_runtime(benchmark::State & state) {
+    Logging::SetLoggingLevel(Logging::Level::ERROR);
+    int i = 0;
+    for(auto _ : state) Logging::Info("sample %d value %f", i++, 0.5);
+    Logging::SetLoggingLevel(Logging::Level::DEBUG);
+}
+BENCHMARK(BM_log_filtered_runtime);
+
+static void BM_log_filtered_compile_time(benchmark::State & state) {
+    int i = 0;
+    for(auto _ : state) {
+        LOG_DEBUG("sample %d value %f", i++, 0.5);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_log_filtered_compile_time);
+
+static void BM_log_async(benchmark::State & state) {
+    DiscardStdout discard;
+    Logging::StartAsync(Logging::Overflow::DROP);
+    int i = 0;
+    for(auto _ : state) Logging::Info("sample %d value %f", i++, 0.5);
+    Logging::StopAsync();
+    state.counters["dropped"] = Logging::DroppedMessages();
+}
+BENCHMARK(BM_log_async);
+
+static void BM_log_deferred(benchmark::State & state) {
+    FILE * null = fopen("/dev/null", "wb");
+    Logging::StartDeferred(null);
+    int i = 0;
+    for(auto _ : state) Logging::Info("sample %d value %f", i++, 0.5);
+    Logging::StopDeferred();
+    fclose(null);
+}
+BENCHMARK(BM_log_deferred);
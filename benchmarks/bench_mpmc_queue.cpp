@@ -0,0 +1,65 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include <thread>
+#include "mpmc_queue.hpp"
+#include "ringbuffer.hpp"
+
+// Every thread pushes one element and pops one, so the queue never fills up
+// and the numbers show the cost of contention on the shared structure.
+
+static MpmcQueue<int, 1024> mpmc_queue;
+
+static void BM_mpmc_queue(benchmark::State & state) {
+    int value{state.thread_index()};
+    for(auto _ : state) {
+        while( ! mpmc_queue.try_push(value) ) std::this_thread::yield();
+        while( ! mpmc_queue.try_pop(value) ) std::this_thread::yield();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mpmc_queue)->ThreadRange(1, 16)->UseRealTime();
+
+static std::mutex ring_mutex;
+static Ringbuffer<int, 1024> mutex_ring;
+
+static void BM_mutex_ringbuffer(benchmark::State & state) {
+    int value{state.thread_index()};
+    for(auto _ : state) {
+        {
+            std::lock_guard lock(ring_mutex);
+            mutex_ring.push_back(value);
+        }
+        for(bool popped = false; ! popped; ) {
+            {
+                std::lock_guard lock(ring_mutex);
+                if( ! mutex_ring.empty() ) {
+                    value = mutex_ring.front();
+                    mutex_ring.pop_front();
+                    popped = true;
+                }
+            }
+            if( ! popped ) std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mutex_ringbuffer)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,92 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "notifying_ringbuffer.hpp"
+#include "spsc_ringbuffer.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static double thread_cpu_seconds() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+enum class Mode { SPIN, SLEEP_POLL, NOTIFY };
+
+// A producer emitting an element every 20us, like a telemetry source, and a
+// consumer waiting for them by spinning on empty(), polling every 100us or
+// sleeping in NotifyingRingbuffer::wait(). Reports the time from push to pop
+// and how much CPU the consumer thread burnt relative to wall time.
+static void BM_consumer_wait(benchmark::State & state, Mode mode) {
+    constexpr int count = 5000;
+    constexpr auto period = std::chrono::microseconds(20);
+    std::vector<Clock::rep> latencies(count);
+    double consumer_cpu = 0, wall = 0;
+    for(auto _ : state) {
+        auto spsc = std::make_unique<SpscRingbuffer<Clock::rep, 1024>>();
+        auto notifying = std::make_unique<NotifyingRingbuffer<Clock::rep, 1024>>();
+        const auto start = Clock::now();
+        std::thread producer([&] {
+            auto next = Clock::now();
+            for(int i = 0; i < count; ++i) {
+                next += period;
+                std::this_thread::sleep_until(next);
+                const Clock::rep stamp = Clock::now().time_since_epoch().count();
+                if(mode == Mode::NOTIFY) notifying->try_push(stamp);
+                else spsc->try_push(stamp);
+            }
+        });
+        const double cpu_start = thread_cpu_seconds();
+        Clock::rep stamp;
+        for(int i = 0; i < count;) {
+            if(mode == Mode::NOTIFY) {
+                notifying->wait();
+                while(notifying->try_pop(stamp)) latencies[i++] = Clock::now().time_since_epoch().count() - stamp;
+            } else {
+                while(spsc->empty()) {
+                    if(mode == Mode::SLEEP_POLL) std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+                while(spsc->try_pop(stamp)) latencies[i++] = Clock::now().time_since_epoch().count() - stamp;
+            }
+        }
+        consumer_cpu += thread_cpu_seconds() - cpu_start;
+        producer.join();
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        wall += elapsed;
+        state.SetIterationTime(elapsed);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const double ns = std::chrono::duration<double, std::nano>(Clock::duration(1)).count();
+    state.counters["p50_ns"] = latencies[count / 2] * ns;
+    state.counters["p99_ns"] = latencies[count * 99 / 100] * ns;
+    state.counters["p999_ns"] = latencies[count * 999 / 1000] * ns;
+    state.counters["consumer_cpu_%"] = 100 * consumer_cpu / wall;
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK_CAPTURE(BM_consumer_wait, spin, Mode::SPIN)->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_consumer_wait, sleep_poll, Mode::SLEEP_POLL)->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_consumer_wait, notify, Mode::NOTIFY)->UseManualTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,71 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "mpmc_queue.hpp"
+#include "spsc_ringbuffer.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// One producer and one consumer thread. The producer stamps every element with
+// the time it was pushed, the consumer records how long it took to arrive.
+template<class Queue>
+static void BM_cross_thread(benchmark::State & state, bool (*push)(Queue &, Clock::rep), bool (*pop)(Queue &, Clock::rep &)) {
+    constexpr int count = 100000;
+    std::vector<Clock::rep> latencies(count);
+    for(auto _ : state) {
+        auto queue = std::make_unique<Queue>();
+        const auto start = Clock::now();
+        std::thread producer([&queue, push] {
+            for(int i = 0; i < count; ++i) {
+                while( ! push(*queue, Clock::now().time_since_epoch().count()) ) std::this_thread::yield();
+            }
+        });
+        Clock::rep stamp;
+        for(int i = 0; i < count; ++i) {
+            while( ! pop(*queue, stamp) ) std::this_thread::yield();
+            latencies[i] = Clock::now().time_since_epoch().count() - stamp;
+        }
+        producer.join();
+        state.SetIterationTime(std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const double ns = std::chrono::duration<double, std::nano>(Clock::duration(1)).count();
+    state.counters["p50_ns"] = latencies[count / 2] * ns;
+    state.counters["p99_ns"] = latencies[count * 99 / 100] * ns;
+    state.counters["p999_ns"] = latencies[count * 999 / 1000] * ns;
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+using Spsc = SpscRingbuffer<Clock::rep, 1024>;
+using Mpmc = MpmcQueue<Clock::rep, 1024>;
+
+BENCHMARK_CAPTURE(BM_cross_thread, spsc_ringbuffer,
+    +[](Spsc & queue, Clock::rep value) { return queue.try_push(value); },
+    +[](Spsc & queue, Clock::rep & value) { return queue.try_pop(value); })
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_cross_thread, mpmc_queue,
+    +[](Mpmc & queue, Clock::rep value) { return queue.try_push(value); },
+    +[](Mpmc & queue, Clock::rep & value) { return queue.try_pop(value); })
+    ->UseManualTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,137 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <benchmark/benchmark.h>
+#include <span>
+#include <vector>
+#include "counter_ringbuffer.hpp"
+#include "ringbuffer.hpp"
+
+// Ringbuffer<T, 1023> and Ringbuffer<T, 1025> index with a modulo,
+// Ringbuffer<T, 1024> with a mask and CounterRingbuffer only masks on access.
+
+template<class Ring>
+static void BM_push_pop(benchmark::State & state) {
+    Ring ring;
+    int value{0};
+    for(auto _ : state) {
+        for(int i = 0; i < 64; ++i) ring.push_back(value++);
+        for(int i = 0; i < 64; ++i) {
+            benchmark::DoNotOptimize(ring.front());
+            ring.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_push_pop<Ringbuffer<int, 1023>>);
+BENCHMARK(BM_push_pop<Ringbuffer<int, 1024>>);
+BENCHMARK(BM_push_pop<Ringbuffer<int, 1025>>);
+BENCHMARK(BM_push_pop<CounterRingbuffer<int, 1024>>);
+
+template<class Ring>
+static void BM_overwrite(benchmark::State & state) {
+    Ring ring;
+    int value{0};
+    for(auto _ : state) {
+        ring.push_back(value++);
+        benchmark::DoNotOptimize(ring.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_overwrite<Ringbuffer<int, 1023>>);
+BENCHMARK(BM_overwrite<Ringbuffer<int, 1024>>);
+BENCHMARK(BM_overwrite<Ringbuffer<int, 1025>>);
+BENCHMARK(BM_overwrite<CounterRingbuffer<int, 1024>>);
+
+template<class Ring>
+static void BM_indexed_sum(benchmark::State & state) {
+    Ring ring;
+    for(int i = 0; i < 2000; ++i) ring.push_back(i);
+    const int size = static_cast<int>(ring.size());
+    for(auto _ : state) {
+        long sum{0};
+        for(int i = 0; i < size; ++i) sum += ring[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_indexed_sum<Ringbuffer<int, 1023>>);
+BENCHMARK(BM_indexed_sum<Ringbuffer<int, 1024>>);
+BENCHMARK(BM_indexed_sum<Ringbuffer<int, 1025>>);
+BENCHMARK(BM_indexed_sum<CounterRingbuffer<int, 1024>>);
+
+template<size_t Bytes>
+struct Payload {
+    unsigned char bytes[Bytes];
+};
+
+template<class T, size_t N>
+static void BM_element_size(benchmark::State & state) {
+    Ringbuffer<T, N> ring;
+    T value{};
+    for(auto _ : state) {
+        for(int i = 0; i < 64; ++i) ring.push_back(value);
+        for(int i = 0; i < 64; ++i) {
+            benchmark::DoNotOptimize(ring.front());
+            ring.pop_front();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+    state.SetBytesProcessed(state.iterations() * 64 * sizeof(T));
+}
+BENCHMARK(BM_element_size<Payload<1>, 256>);
+BENCHMARK(BM_element_size<Payload<16>, 256>);
+BENCHMARK(BM_element_size<Payload<64>, 256>);
+BENCHMARK(BM_element_size<Payload<256>, 256>);
+BENCHMARK(BM_element_size<Payload<64>, 255>);
+
+template<class T, size_t N>
+static void BM_bulk(benchmark::State & state) {
+    Ringbuffer<T, N> ring;
+    const size_t batch = static_cast<size_t>(state.range(0));
+    std::vector<T> in(batch), out(batch);
+    for(auto _ : state) {
+        ring.push_back(std::span<const T>(in));
+        benchmark::DoNotOptimize(ring.pop_front_into(out));
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+    state.SetBytesProcessed(state.iterations() * batch * sizeof(T));
+}
+BENCHMARK(BM_bulk<int, 1024>)->Arg(16)->Arg(256)->Arg(1000);
+BENCHMARK(BM_bulk<int, 1025>)->Arg(16)->Arg(256)->Arg(1000);
+BENCHMARK(BM_bulk<Payload<64>, 1024>)->Arg(16)->Arg(256);
+
+template<class T, size_t N>
+static void BM_single_vs_bulk(benchmark::State & state) {
+    Ringbuffer<T, N> ring;
+    const size_t batch = static_cast<size_t>(state.range(0));
+    std::vector<T> in(batch), out(batch);
+    for(auto _ : state) {
+        for(const T & value : in) ring.push_back(value);
+        for(T & value : out) {
+            value = ring.front();
+            ring.pop_front();
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * batch);
+    state.SetBytesProcessed(state.iterations() * batch * sizeof(T));
+}
+BENCHMARK(BM_single_vs_bulk<int, 1024>)->Arg(16)->Arg(256)->Arg(1000);
+BENCHMARK(BM_single_vs_bulk<int, 1025>)->Arg(16)->Arg(256)->Arg(1000);
@@ -0,0 +1,107 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include "ringbuffer.hpp"
+#include "ringbuffer_simd.hpp"
+
+// Scans over the last samples of a wrapped Ringbuffer<T, 4096>: operator[]
+// with an index wrap per element against ringbuffer_simd over the segments.
+// Build with -mavx2 to get the AVX2 kernels, SSE2 is the x86-64 default.
+
+template<class T>
+static Ringbuffer<T, 4096> & samples() {
+    static Ringbuffer<T, 4096> ring = [] {
+        Ringbuffer<T, 4096> filled;
+        for(int i = 0; i < 4096 + 1000; ++i) filled.push_back(static_cast<T>(i % 1000 - 500));
+        return filled;
+    }();
+    return ring;
+}
+
+template<class T>
+static void BM_scalar_sum(benchmark::State & state) {
+    const auto & ring = samples<T>();
+    const int size = static_cast<int>(ring.size());
+    for(auto _ : state) {
+        ringbuffer_simd::sum_type<T> sum{0};
+        for(int i = 0; i < size; ++i) sum += ring[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_scalar_sum<float>);
+BENCHMARK(BM_scalar_sum<int16_t>);
+
+template<class T>
+static void BM_simd_sum(benchmark::State & state) {
+    const auto & ring = samples<T>();
+    for(auto _ : state) benchmark::DoNotOptimize(ringbuffer_simd::sum(ring));
+    state.SetItemsProcessed(state.iterations() * ring.size());
+}
+BENCHMARK(BM_simd_sum<float>);
+BENCHMARK(BM_simd_sum<int16_t>);
+
+template<class T>
+static void BM_scalar_max(benchmark::State & state) {
+    const auto & ring = samples<T>();
+    const int size = static_cast<int>(ring.size());
+    for(auto _ : state) {
+        T max = ring[0];
+        for(int i = 1; i < size; ++i) max = std::max(max, ring[i]);
+        benchmark::DoNotOptimize(max);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_scalar_max<float>);
+BENCHMARK(BM_scalar_max<int16_t>);
+
+template<class T>
+static void BM_simd_max(benchmark::State & state) {
+    const auto & ring = samples<T>();
+    for(auto _ : state) benchmark::DoNotOptimize(ringbuffer_simd::max(ring));
+    state.SetItemsProcessed(state.iterations() * ring.size());
+}
+BENCHMARK(BM_simd_max<float>);
+BENCHMARK(BM_simd_max<int16_t>);
+
+// No element crosses the threshold, so the whole buffer is scanned.
+template<class T>
+static void BM_scalar_find_above(benchmark::State & state) {
+    const auto & ring = samples<T>();
+    const int size = static_cast<int>(ring.size());
+    for(auto _ : state) {
+        int idx = 0;
+        while(idx < size && !(ring[idx] > T(600))) idx++;
+        benchmark::DoNotOptimize(idx);
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_scalar_find_above<float>);
+BENCHMARK(BM_scalar_find_above<int16_t>);
+
+template<class T>
+static void BM_simd_find_above(benchmark::State & state) {
+    const auto & ring = samples<T>();
+    for(auto _ : state) benchmark::DoNotOptimize(ringbuffer_simd::find_above(ring, T(600)));
+    state.SetItemsProcessed(state.iterations() * ring.size());
+}
+BENCHMARK(BM_simd_find_above<float>);
+BENCHMARK(BM_simd_find_above<int16_t>);
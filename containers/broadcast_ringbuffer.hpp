@@ -0,0 +1,134 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "cache_line.hpp"
+
+/// Ring buffer with one writer and any number of readers, each reader with its own cursor.
+///
+/// Like Ringbuffer::push_back the writer never waits and overwrites the oldest
+/// element when the ring is full; a reader which falls more than N elements
+/// behind is lapped, notices it on its next read and skips ahead to the oldest
+/// element still in the ring. Every slot is a seqlock: its sequence number is
+/// odd while the writer copies into it and even once the element is complete,
+/// so readers copy elements out and retry if the writer got there in between.
+/// The writer and each Reader may live on different threads; one ring carries
+/// any number of consumers with a single copy of every element.
+template<class T, size_t N>
+class BroadcastRingbuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "readers copy elements while they may be overwritten");
+    static_assert(N > 0);
+
+    struct Slot {
+        std::atomic<uint64_t> sequence{0}; // 2 * (element index + 1) when complete
+        T value;
+    };
+
+    // Written by the writer only.
+    alignas(cache_line_size) std::atomic<uint64_t> m_published{0};
+    alignas(cache_line_size) Slot m_slots[N];
+
+    static constexpr size_t slot_of(uint64_t index) { return static_cast<size_t>(index % N); }
+
+public:
+    enum class ReadResult {
+        OK,
+        EMPTY,
+        LAPPED,     // elements were overwritten before they were read, the cursor moved past them
+    };
+
+    class Reader {
+        const BroadcastRingbuffer * m_ring;
+        uint64_t m_cursor;
+        uint64_t m_lost{0};
+
+        friend class BroadcastRingbuffer;
+        Reader(const BroadcastRingbuffer & ring, uint64_t cursor) : m_ring(&ring), m_cursor(cursor) {}
+
+    public:
+        /// @brief Copies the next element into item. On LAPPED item is untouched
+        /// and the next call continues with the oldest element left.
+        ReadResult try_read(T & item) {
+            const Slot & slot = m_ring->m_slots[slot_of(m_cursor)];
+            const uint64_t expected = 2 * (m_cursor + 1);
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if(before < expected) return ReadResult::EMPTY;
+            if(before == expected) {
+                memcpy(&item, &slot.value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if(slot.sequence.load(std::memory_order_relaxed) == expected) {
+                    m_cursor++;
+                    return ReadResult::OK;
+                }
+            }
+            // The writer may be filling the slot of the oldest element right now, start one after it.
+            // m_published can lag the slot sequence, the element at the cursor is gone either way.
+            const uint64_t published = m_ring->m_published.load(std::memory_order_acquire);
+            const uint64_t oldest = std::max(published - N + 1, m_cursor + 1);
+            m_lost += oldest - m_cursor;
+            m_cursor = oldest;
+            return ReadResult::LAPPED;
+        }
+
+        /// @brief Elements published but not yet read, at most N.
+        size_t available() const {
+            const uint64_t published = m_ring->m_published.load(std::memory_order_acquire);
+            return published - m_cursor < N ? static_cast<size_t>(published - m_cursor) : N;
+        }
+        /// @brief Elements skipped because they were overwritten before they were read.
+        uint64_t lost() const { return m_lost; }
+    };
+
+    BroadcastRingbuffer() = default;
+    BroadcastRingbuffer(const BroadcastRingbuffer &) = delete;
+    BroadcastRingbuffer & operator=(const BroadcastRingbuffer &) = delete;
+
+    /// @brief Writer side. Publishes item to all readers, overwriting the oldest element when full.
+    void push_back(const T & item) {
+        const uint64_t index = m_published.load(std::memory_order_relaxed);
+        Slot & slot = m_slots[slot_of(index)];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&slot.value, &item, sizeof(T));
+        slot.sequence.store(2 * (index + 1), std::memory_order_release);
+        m_published.store(index + 1, std::memory_order_release);
+    }
+
+    /// @brief A reader which sees elements published from now on.
+    Reader subscribe() const {
+        return Reader(*this, m_published.load(std::memory_order_acquire));
+    }
+    /// @brief A reader which starts with the oldest element still in the ring.
+    Reader subscribe_oldest() const {
+        const uint64_t published = m_published.load(std::memory_order_acquire);
+        return Reader(*this, published > N - 1 ? published - N + 1 : 0);
+    }
+
+    /// @brief Number of elements published so far.
+    uint64_t published() const { return m_published.load(std::memory_order_acquire); }
+    static constexpr size_t capacity() { return N; }
+};
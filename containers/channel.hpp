@@ -0,0 +1,159 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "executor.hpp"
+#include "intrusive_list.hpp"
+#include "ringbuffer.hpp"
+
+/// Bounded channel between coroutines on one Executor, buffering in a Ringbuffer<T, N>.
+///
+/// co_await push(value) suspends while the buffer is full, co_await pop() while
+/// it is empty; the coroutine on the other side is scheduled on the executor as
+/// soon as data or room appears, with no thread per stage. A value pushed while a
+/// consumer waits goes to it directly without touching the buffer. Waiters sit on
+/// intrusive lists inside their own coroutine frames, so nothing is allocated.
+/// With N == 1 the buffer holds nothing and every value is handed over directly
+/// from producer to consumer, whichever of them comes first waits for the other.
+/// After close() pushes fail and pop() returns std::nullopt once the buffer is drained.
+template<class T, size_t N>
+class Channel {
+public:
+    class PushAwaiter : public IntrusiveHook<> {
+        friend class Channel;
+        Channel & m_channel;
+        T m_value;
+        std::coroutine_handle<> m_handle;
+        bool m_pushed{false};
+    public:
+        PushAwaiter(Channel & channel, T && value) : m_channel(channel), m_value(std::move(value)) {}
+        bool await_ready() {
+            m_pushed = m_channel.push_from(m_value);
+            return m_pushed || m_channel.m_closed;
+        }
+        void await_suspend(std::coroutine_handle<> handle) {
+            m_handle = handle;
+            m_channel.m_pushers.push_back(*this);
+        }
+        /// @brief false if the channel was closed before the value got in.
+        bool await_resume() const noexcept { return m_pushed; }
+    };
+
+    class PopAwaiter : public IntrusiveHook<> {
+        friend class Channel;
+        Channel & m_channel;
+        std::optional<T> m_value;
+        std::coroutine_handle<> m_handle;
+    public:
+        explicit PopAwaiter(Channel & channel) : m_channel(channel) {}
+        bool await_ready() {
+            m_value = m_channel.try_pop();
+            return m_value || m_channel.m_closed;
+        }
+        void await_suspend(std::coroutine_handle<> handle) {
+            m_handle = handle;
+            m_channel.m_poppers.push_back(*this);
+        }
+        /// @brief std::nullopt if the channel is closed and drained.
+        std::optional<T> await_resume() { return std::move(m_value); }
+    };
+
+private:
+    Executor & m_executor;
+    Ringbuffer<T, N> m_buffer;
+    IntrusiveList<PushAwaiter> m_pushers;
+    IntrusiveList<PopAwaiter> m_poppers;
+    bool m_closed{false};
+
+    /// @brief Moves value to a waiting consumer or into the buffer, false if full or closed.
+    bool push_from(T & value) {
+        if(m_closed) return false;
+        if( ! m_poppers.empty() ) {
+            PopAwaiter & popper = m_poppers.front();
+            m_poppers.pop_front();
+            popper.m_value.emplace(std::move(value));
+            m_executor.schedule(popper.m_handle);
+            return true;
+        }
+        if(m_buffer.full()) return false;
+        m_buffer.push_back(std::move(value));
+        return true;
+    }
+
+    /// @brief Takes the oldest waiting producer off the list and schedules it, its value is accepted.
+    PushAwaiter & resume_pusher() {
+        PushAwaiter & pusher = m_pushers.front();
+        m_pushers.pop_front();
+        pusher.m_pushed = true;
+        m_executor.schedule(pusher.m_handle);
+        return pusher;
+    }
+
+public:
+    explicit Channel(Executor & executor) : m_executor(executor) {}
+    Channel(const Channel &) = delete;
+    Channel & operator=(const Channel &) = delete;
+
+    /// @brief co_await returns whether value was accepted, i.e. false once closed.
+    PushAwaiter push(T value) { return PushAwaiter(*this, std::move(value)); }
+    /// @brief co_await returns the next value, std::nullopt once closed and drained.
+    PopAwaiter pop() { return PopAwaiter(*this); }
+
+    /// @brief Non-suspending push for code outside coroutines, false if full or closed.
+    bool try_push(T value) { return push_from(value); }
+    /// @brief Non-suspending pop, std::nullopt if empty.
+    std::optional<T> try_pop() {
+        if(m_buffer.empty()) {
+            // Producers only wait on an empty buffer when it has no room at all (N == 1).
+            if(m_pushers.empty()) return std::nullopt;
+            return std::optional<T>(std::move(resume_pusher().m_value));
+        }
+        std::optional<T> value(std::move(m_buffer.front()));
+        m_buffer.pop_front();
+        if( ! m_pushers.empty() ) {
+            // Room appeared, the oldest waiting producer gets it.
+            m_buffer.push_back(std::move(resume_pusher().m_value));
+        }
+        return value;
+    }
+
+    /// @brief Wakes every waiter: pending pushes fail, pops get what is left, then std::nullopt.
+    void close() {
+        m_closed = true;
+        while( ! m_pushers.empty() ) {
+            m_executor.schedule(m_pushers.front().m_handle);
+            m_pushers.pop_front();
+        }
+        while( ! m_poppers.empty() ) {
+            m_executor.schedule(m_poppers.front().m_handle);
+            m_poppers.pop_front();
+        }
+    }
+
+    bool closed() const { return m_closed; }
+    bool empty() const { return m_buffer.empty(); }
+    size_t size() const { return m_buffer.size(); }
+    constexpr size_t capacity() const { return m_buffer.capacity(); }
+};
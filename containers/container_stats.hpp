@@ -0,0 +1,95 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/// Snapshot of a container's counters, see Ringbuffer::stats and LList::stats.
+struct ContainerStats {
+    size_t size{0};
+    size_t capacity{0};     // 0 for containers without a fixed capacity
+    size_t high_water{0};   // largest size reached
+    uint64_t pushes{0};
+    uint64_t pops{0};
+    uint64_t overwrites{0}; // pushes which replaced the oldest, still unread element
+    uint64_t drops{0};      // pushes which failed, e.g. node allocation threw
+    uint64_t allocations{0};
+    uint64_t deallocations{0};
+
+    /// printf formats of format_text and format_json, taking name followed by the
+    /// counters in declaration order as size_t, size_t, size_t and unsigned long long.
+    static constexpr const char * text_format =
+        "%s: size=%zu capacity=%zu high_water=%zu pushes=%llu pops=%llu overwrites=%llu drops=%llu"
+        " allocations=%llu deallocations=%llu";
+    static constexpr const char * json_format =
+        "{\"name\":\"%s\",\"size\":%zu,\"capacity\":%zu,\"high_water\":%zu,\"pushes\":%llu,\"pops\":%llu,"
+        "\"overwrites\":%llu,\"drops\":%llu,\"allocations\":%llu,\"deallocations\":%llu}";
+
+    /// @brief One line of "key=value" pairs, snprintf semantics.
+    int format_text(char * out, size_t out_size, const char * name) const {
+        return format(out, out_size, text_format, name);
+    }
+    /// @brief A JSON object, name must not need escaping. snprintf semantics.
+    int format_json(char * out, size_t out_size, const char * name) const {
+        return format(out, out_size, json_format, name);
+    }
+
+private:
+    int format(char * out, size_t out_size, const char * fmt, const char * name) const {
+        return snprintf(out, out_size, fmt,
+            name, size, capacity, high_water, (unsigned long long)pushes, (unsigned long long)pops,
+            (unsigned long long)overwrites, (unsigned long long)drops,
+            (unsigned long long)allocations, (unsigned long long)deallocations);
+    }
+};
+
+/// Stats policies for the Stats template parameter of Ringbuffer and LList.
+/// The containers report every event to the policy; NoStats ignores them and
+/// takes no space, so a container without stats compiles to the same code.
+struct NoStats {
+    static constexpr bool enabled = false;
+    constexpr void pushed(size_t, size_t) {}
+    constexpr void popped(size_t) {}
+    constexpr void overwritten(size_t) {}
+    constexpr void dropped() {}
+    constexpr void allocated() {}
+    constexpr void deallocated() {}
+    constexpr ContainerStats snapshot() const { return {}; }
+};
+
+/// Plain counters, not synchronised; a container is only used by one thread at a time anyway.
+struct CountingStats {
+    static constexpr bool enabled = true;
+    /// @brief count elements were added, size_after is the resulting size.
+    constexpr void pushed(size_t count, size_t size_after) {
+        m_stats.pushes += count;
+        m_stats.high_water = std::max(m_stats.high_water, size_after);
+    }
+    constexpr void popped(size_t count) { m_stats.pops += count; }
+    constexpr void overwritten(size_t count) { m_stats.overwrites += count; }
+    constexpr void dropped() { m_stats.drops++; }
+    constexpr void allocated() { m_stats.allocations++; }
+    constexpr void deallocated() { m_stats.deallocations++; }
+    constexpr ContainerStats snapshot() const { return m_stats; }
+private:
+    ContainerStats m_stats;
+};
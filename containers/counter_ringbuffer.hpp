@@ -0,0 +1,110 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#ifdef USE_ITERATORS
+    #include <iterator>
+    #include <initializer_list>
+#endif
+
+#include <cstddef>
+
+/// Ring buffer with free running head and tail counters.
+///
+/// Counters are only masked when a slot is accessed, so full(), empty() and
+/// size() are plain subtractions and all N slots are usable. N must be a power
+/// of two. Like Ringbuffer, pushing into a full buffer overwrites the element
+/// at the opposite end.
+template<class T, size_t N>
+class CounterRingbuffer {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "CounterRingbuffer capacity must be a power of two");
+    static constexpr size_t mask = N - 1;
+
+    T m_data[N];
+public:
+#ifdef USE_ITERATORS
+    class iterator {
+        CounterRingbuffer *m_buf{nullptr};
+        size_t m_idx{0};
+        friend class CounterRingbuffer;
+        constexpr iterator(CounterRingbuffer * _buf, size_t _idx) : m_buf(_buf), m_idx(_idx) {}
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        explicit constexpr iterator() = delete;
+        constexpr iterator& operator++() { m_idx++; return *this; }
+        constexpr iterator operator++(int) { auto tmp = *this; m_idx++; return tmp; }
+        constexpr bool operator==(iterator other) const { return m_idx == other.m_idx; }
+        constexpr bool operator!=(iterator other) const { return !(*this == other); }
+        constexpr T& operator*() const { return m_buf->m_data[m_idx & mask]; }
+    };
+#endif
+protected:
+
+    size_t m_head, m_tail;
+
+public:
+    constexpr CounterRingbuffer() : m_head(0), m_tail(0) {}
+    CounterRingbuffer(const CounterRingbuffer &) = delete;
+    CounterRingbuffer & operator=(const CounterRingbuffer &) = delete;
+
+    constexpr void push_front(const T & item) {
+        if(full()) m_tail--;
+        m_data[--m_head & mask] = item;
+    }
+    constexpr void push_back(const T & item) {
+        if(full()) m_head++;
+        m_data[m_tail++ & mask] = item;
+    }
+    constexpr const T & front() const {
+        return m_data[m_head & mask];
+    }
+    constexpr const T & back() const {
+        return m_data[(m_tail - 1) & mask];
+    }
+    constexpr void pop_front() {
+        m_head++;
+    }
+    constexpr void pop_back() {
+        m_tail--;
+    }
+    constexpr bool full() const { return m_tail - m_head == N; }
+    constexpr bool empty() const { return m_head == m_tail; }
+    constexpr size_t size() const { return m_tail - m_head; }
+    constexpr size_t capacity() const { return N; }
+    constexpr T & operator[](int idx) {
+        return idx >= 0 ?
+            m_data[(m_head + idx) & mask]
+            : m_data[(m_tail + idx) & mask];
+    }
+#ifdef USE_ITERATORS
+    constexpr iterator begin() { return iterator(this, m_head); }
+    constexpr iterator end() { return iterator(this, m_tail); }
+    constexpr CounterRingbuffer(std::initializer_list<T> init) : m_head(0), m_tail(0) {
+        for(T value : init) {
+            push_back(value);
+        }
+    }
+#endif
+};
@@ -0,0 +1,241 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+/// Ring buffer with runtime capacity that grows on demand.
+///
+/// Nothing is allocated until the first push. A full buffer doubles its
+/// capacity until Growth::max_capacity is reached, from then on pushing
+/// overwrites the oldest element like Ringbuffer does. With Growth::shrink the
+/// capacity is halved again (down to initial_capacity) whenever occupancy drops
+/// to a quarter. Reallocation keeps the element order by relocating the two
+/// contiguous halves, with memcpy for trivially copyable T.
+template<class T, class Allocator = std::allocator<T>>
+class DynamicRingbuffer {
+    using Traits = std::allocator_traits<Allocator>;
+public:
+    struct Growth {
+        size_t initial_capacity;
+        size_t max_capacity;
+        bool shrink;
+    };
+    static constexpr Growth default_growth{8, std::numeric_limits<size_t>::max(), false};
+
+    /// Up to two contiguous runs of elements, second is empty unless the contents wrap.
+    struct Segments {
+        std::span<T> first;
+        std::span<T> second;
+        size_t size() const { return first.size() + second.size(); }
+    };
+
+private:
+    T *m_data{nullptr};
+    size_t m_capacity{0};
+    size_t m_head{0};
+    size_t m_size{0};
+    Growth m_growth;
+    [[no_unique_address]] Allocator m_alloc;
+
+    size_t slot(size_t offset) const {
+        const size_t idx = m_head + offset;
+        return idx >= m_capacity ? idx - m_capacity : idx;
+    }
+
+    void relocate(size_t capacity) {
+        assert(capacity >= m_size);
+        T *data = capacity ? Traits::allocate(m_alloc, capacity) : nullptr;
+        const Segments src = read_segments();
+        size_t count = 0;
+        for(std::span<T> part : {src.first, src.second}) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if( ! part.empty() ) std::memcpy(data + count, part.data(), part.size_bytes());
+                count += part.size();
+            } else {
+                for(T & item : part) {
+                    Traits::construct(m_alloc, data + count++, std::move(item));
+                    Traits::destroy(m_alloc, &item);
+                }
+            }
+        }
+        release();
+        m_data = data;
+        m_capacity = capacity;
+        m_head = 0;
+    }
+
+    void release() {
+        if(m_data) Traits::deallocate(m_alloc, m_data, m_capacity);
+        m_data = nullptr;
+        m_capacity = 0;
+    }
+
+    /// @brief Grows when full, returns false if the maximum capacity is reached.
+    bool make_room() {
+        if(m_size < m_capacity) return true;
+        if(m_capacity >= m_growth.max_capacity) return false;
+        size_t grown = m_capacity ? m_capacity * 2 : m_growth.initial_capacity;
+        if(grown < m_capacity) grown = m_growth.max_capacity; // overflow
+        relocate(std::min(grown, m_growth.max_capacity));
+        return true;
+    }
+
+    void maybe_shrink() {
+        if( ! m_growth.shrink || m_capacity <= m_growth.initial_capacity ) return;
+        if(m_size <= m_capacity / 4) relocate(std::max(m_growth.initial_capacity, m_capacity / 2));
+    }
+
+    void take(DynamicRingbuffer & other) {
+        m_data = std::exchange(other.m_data, nullptr);
+        m_capacity = std::exchange(other.m_capacity, 0);
+        m_head = std::exchange(other.m_head, 0);
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+public:
+    DynamicRingbuffer() : DynamicRingbuffer(default_growth) {}
+    explicit DynamicRingbuffer(Growth growth, const Allocator & alloc = Allocator())
+        : m_growth(growth), m_alloc(alloc) {
+        assert(growth.initial_capacity > 0 && growth.initial_capacity <= growth.max_capacity);
+    }
+    DynamicRingbuffer(const DynamicRingbuffer &) = delete;
+    DynamicRingbuffer & operator=(const DynamicRingbuffer &) = delete;
+    DynamicRingbuffer(DynamicRingbuffer && other)
+        : m_growth(other.m_growth), m_alloc(std::move(other.m_alloc)) {
+        take(other);
+    }
+    /// Storage is taken over when the allocators are interchangeable,
+    /// otherwise elements are moved one by one.
+    DynamicRingbuffer & operator=(DynamicRingbuffer && other) {
+        if(this == &other) return *this;
+        clear();
+        release();
+        m_growth = other.m_growth;
+        if(Traits::is_always_equal::value || m_alloc == other.m_alloc) {
+            take(other);
+        } else {
+            reserve(other.size());
+            while( ! other.empty() ) {
+                push_back(std::move(other.front()));
+                other.pop_front();
+            }
+        }
+        return *this;
+    }
+    ~DynamicRingbuffer() {
+        clear();
+        release();
+    }
+
+    // When full, args may refer to an element which growing frees or which is
+    // overwritten, so the new element is built before making room.
+    template<class... Args>
+    T & emplace_back(Args &&... args) {
+        if(m_size == m_capacity) {
+            T item(std::forward<Args>(args)...);
+            if( ! make_room() ) pop_front();
+            Traits::construct(m_alloc, m_data + slot(m_size), std::move(item));
+        } else {
+            Traits::construct(m_alloc, m_data + slot(m_size), std::forward<Args>(args)...);
+        }
+        m_size++;
+        return back();
+    }
+    template<class... Args>
+    T & emplace_front(Args &&... args) {
+        if(m_size == m_capacity) {
+            T item(std::forward<Args>(args)...);
+            if( ! make_room() ) pop_back();
+            m_head = m_head ? m_head - 1 : m_capacity - 1;
+            Traits::construct(m_alloc, m_data + m_head, std::move(item));
+        } else {
+            m_head = m_head ? m_head - 1 : m_capacity - 1;
+            Traits::construct(m_alloc, m_data + m_head, std::forward<Args>(args)...);
+        }
+        m_size++;
+        return front();
+    }
+    void push_back(const T & item) { emplace_back(item); }
+    void push_back(T && item) { emplace_back(std::move(item)); }
+    void push_front(const T & item) { emplace_front(item); }
+    void push_front(T && item) { emplace_front(std::move(item)); }
+
+    void pop_front() {
+        assert( ! empty() );
+        Traits::destroy(m_alloc, m_data + m_head);
+        m_head = slot(1);
+        m_size--;
+        maybe_shrink();
+    }
+    void pop_back() {
+        assert( ! empty() );
+        Traits::destroy(m_alloc, m_data + slot(m_size - 1));
+        m_size--;
+        maybe_shrink();
+    }
+    /// @brief Destroys all elements, the storage is kept.
+    void clear() {
+        if constexpr ( ! std::is_trivially_destructible_v<T> ) {
+            for(size_t i = 0; i < m_size; ++i) Traits::destroy(m_alloc, m_data + slot(i));
+        }
+        m_head = 0;
+        m_size = 0;
+    }
+
+    /// @brief Grows the storage to hold at least capacity elements (up to the maximum).
+    void reserve(size_t capacity) {
+        capacity = std::min(capacity, m_growth.max_capacity);
+        if(capacity > m_capacity) relocate(capacity);
+    }
+    /// @brief Shrinks the storage to size(), an empty buffer releases it entirely.
+    void shrink_to_fit() {
+        if(m_size < m_capacity) relocate(m_size);
+    }
+
+    T & front() { return m_data[m_head]; }
+    const T & front() const { return m_data[m_head]; }
+    T & back() { return m_data[slot(m_size - 1)]; }
+    const T & back() const { return m_data[slot(m_size - 1)]; }
+    T & operator[](size_t idx) { return m_data[slot(idx)]; }
+    const T & operator[](size_t idx) const { return m_data[slot(idx)]; }
+
+    /// @brief Contained elements, front to back.
+    Segments read_segments() {
+        if(m_head + m_size <= m_capacity) return { std::span<T>(m_data + m_head, m_size), {} };
+        return { std::span<T>(m_data + m_head, m_capacity - m_head), std::span<T>(m_data, slot(m_size)) };
+    }
+
+    /// @brief True when the next push overwrites the oldest element.
+    bool full() const { return m_size == m_capacity && m_capacity >= m_growth.max_capacity; }
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    size_t max_capacity() const { return m_growth.max_capacity; }
+    Allocator get_allocator() const { return m_alloc; }
+};
@@ -0,0 +1,109 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "dynamic_ringbuffer.hpp"
+#include "intrusive_list.hpp"
+
+class Executor;
+
+/// Coroutine started by Executor::spawn. It runs until it first suspends on
+/// an awaitable (e.g. a Channel) and is resumed by the executor from then on.
+/// A Task which is never spawned is destroyed without running.
+class Task {
+public:
+    struct promise_type : IntrusiveHook<> {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        // The frame frees itself when done, its hook unlinks it from Executor's live tasks.
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    Task(Task && other) : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    Task & operator=(Task &&) = delete;
+    ~Task() { if(m_handle) m_handle.destroy(); }
+
+private:
+    friend class Executor;
+    explicit Task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/// Single-threaded run queue of coroutines. Nothing runs until run() is called,
+/// which resumes ready coroutines in FIFO order until none is left. Tasks still
+/// suspended (e.g. on a Channel nobody writes to) are destroyed with the executor.
+class Executor {
+    DynamicRingbuffer<std::coroutine_handle<>> m_ready;
+    IntrusiveList<Task::promise_type> m_tasks;
+
+public:
+    Executor() = default;
+    Executor(const Executor &) = delete;
+    Executor & operator=(const Executor &) = delete;
+    ~Executor() {
+        while( ! m_tasks.empty() ) {
+            std::coroutine_handle<Task::promise_type>::from_promise(m_tasks.front()).destroy();
+        }
+    }
+
+    /// @brief Takes over task and queues it to start on the next run().
+    void spawn(Task task) {
+        std::coroutine_handle<Task::promise_type> handle = std::exchange(task.m_handle, nullptr);
+        m_tasks.push_back(handle.promise());
+        schedule(handle);
+    }
+    /// @brief Queues a suspended coroutine to be resumed.
+    void schedule(std::coroutine_handle<> handle) { m_ready.push_back(handle); }
+
+    /// @brief Resumes the oldest ready coroutine, returns false if there was none.
+    bool run_one() {
+        if(m_ready.empty()) return false;
+        std::coroutine_handle<> handle = m_ready.front();
+        m_ready.pop_front();
+        handle.resume();
+        return true;
+    }
+    /// @brief Runs until no coroutine is ready, returns the number of resumptions.
+    size_t run() {
+        size_t count = 0;
+        while(run_one()) count++;
+        return count;
+    }
+
+    /// @brief Number of spawned tasks which have not finished.
+    size_t tasks() const { return m_tasks.size(); }
+
+    /// @brief co_await executor.yield() lets the other ready coroutines run first.
+    auto yield() {
+        struct Awaiter {
+            Executor & executor;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) { executor.schedule(handle); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+};
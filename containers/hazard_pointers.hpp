@@ -0,0 +1,137 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "cache_line.hpp"
+
+/// Hazard pointers (M. Michael) for lock-free structures which free nodes
+/// while other threads may still be reading them.
+///
+/// Before dereferencing a shared node a thread publishes it with protect().
+/// A node unlinked from the structure is handed to retire() instead of being
+/// freed; it is only freed once no thread has it published. Each thread owns
+/// one Record with per_thread hazard slots, claimed on first use and released
+/// when the thread exits. Retired nodes left over by an exiting thread are
+/// freed by the next thread claiming the record, or at program exit.
+class HazardPointers {
+public:
+    static constexpr size_t max_threads = 128;
+    static constexpr size_t per_thread = 2;
+    using Deleter = void (*)(void *);
+
+private:
+    struct alignas(cache_line_size) Record {
+        std::atomic<void *> hazards[per_thread]{};
+        std::atomic<bool> in_use{false};
+        std::vector<std::pair<void *, Deleter>> retired; // owner only
+        // At static destruction no thread may read the nodes anymore.
+        ~Record() {
+            for(auto & [node, deleter] : retired) deleter(node);
+        }
+    };
+    static Record records[max_threads];
+
+    // Frees retired nodes only after this many pile up, so scanning all
+    // hazard slots is amortised over many retire() calls.
+    static constexpr size_t scan_threshold = 2 * max_threads * per_thread;
+
+    class Owner {
+        Record * m_record{nullptr};
+    public:
+        Record & record() {
+            if( ! m_record ) {
+                for(Record & candidate : records) {
+                    bool expected = false;
+                    if(candidate.in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                        m_record = &candidate;
+                        return candidate;
+                    }
+                }
+                throw std::runtime_error("HazardPointers: more than max_threads threads");
+            }
+            return *m_record;
+        }
+        ~Owner() {
+            if( ! m_record ) return;
+            for(auto & hazard : m_record->hazards) hazard.store(nullptr, std::memory_order_release);
+            scan(*m_record);
+            m_record->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    static Record & own() {
+        thread_local Owner owner;
+        return owner.record();
+    }
+
+    static void scan(Record & record) {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::vector<void *> protected_nodes;
+        protected_nodes.reserve(max_threads * per_thread);
+        for(Record & other : records) {
+            for(auto & hazard : other.hazards) {
+                if(void * node = hazard.load(std::memory_order_acquire)) protected_nodes.push_back(node);
+            }
+        }
+        std::sort(protected_nodes.begin(), protected_nodes.end());
+        auto still_protected = [&](const std::pair<void *, Deleter> & retired) {
+            if(std::binary_search(protected_nodes.begin(), protected_nodes.end(), retired.first)) return true;
+            retired.second(retired.first);
+            return false;
+        };
+        auto kept = std::partition(record.retired.begin(), record.retired.end(), still_protected);
+        record.retired.erase(kept, record.retired.end());
+    }
+
+public:
+    /// @brief Loads src and publishes the result in hazard slot, retrying until
+    /// the published pointer is still the current value of src.
+    template<class T>
+    static T * protect(size_t slot, const std::atomic<T *> & src) {
+        auto & hazard = own().hazards[slot];
+        T * node = src.load(std::memory_order_relaxed);
+        for(;;) {
+            hazard.store(node, std::memory_order_seq_cst);
+            T * current = src.load(std::memory_order_seq_cst);
+            if(current == node) return node;
+            node = current;
+        }
+    }
+
+    static void clear(size_t slot) {
+        own().hazards[slot].store(nullptr, std::memory_order_release);
+    }
+
+    /// @brief Frees node with deleter once no hazard slot holds it. node must
+    /// already be unreachable for threads which have not protected it yet.
+    static void retire(void * node, Deleter deleter) {
+        Record & record = own();
+        record.retired.emplace_back(node, deleter);
+        if(record.retired.size() >= scan_threshold) scan(record);
+    }
+};
+
+inline HazardPointers::Record HazardPointers::records[HazardPointers::max_threads];
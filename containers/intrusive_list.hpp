@@ -0,0 +1,187 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+
+#ifdef USE_ITERATORS
+    #include <iterator>
+#endif
+
+
+/// Default tag for objects which sit on a single kind of IntrusiveList.
+struct DefaultHookTag {};
+
+/// Link fields embedded into an object by inheriting from this hook. An object
+/// may sit on several lists at once by inheriting one hook per distinct Tag.
+/// The hook unlinks itself when the object is destroyed, copies start unlinked.
+template<class Tag = DefaultHookTag>
+class IntrusiveHook {
+    IntrusiveHook * prev{nullptr};
+    IntrusiveHook * next{nullptr};
+    template<class, class> friend class IntrusiveList;
+public:
+    IntrusiveHook() = default;
+    IntrusiveHook(const IntrusiveHook &) {}
+    IntrusiveHook & operator=(const IntrusiveHook &) { return *this; }
+    ~IntrusiveHook() { unlink(); }
+
+    bool is_linked() const { return next != nullptr; }
+
+    /// @brief Removes the object from whichever list holds it, O(1). No-op when not linked.
+    void unlink() {
+        if( ! next ) return;
+        prev->next = next;
+        next->prev = prev;
+        prev = next = nullptr;
+    }
+};
+
+/// Doubly linked list of objects which embed their own IntrusiveHook<Tag>.
+/// Nothing is allocated and nothing is copied; the list only links objects
+/// owned elsewhere, which must outlive their membership. The list is circular
+/// through a sentinel hook, so linking and unlinking never branch on the ends.
+/// size() walks the list, since objects may unlink themselves at any time.
+template<class T, class Tag = DefaultHookTag>
+class IntrusiveList {
+    using Hook = IntrusiveHook<Tag>;
+    Hook sentinel;
+
+    static T & value(Hook * hook) { return static_cast<T &>(*hook); }
+    static Hook * hook(T & item) { return static_cast<Hook *>(&item); }
+
+    static void link_before(Hook * pos, Hook * node) {
+        assert( ! node->is_linked() );
+        node->next = pos;
+        node->prev = pos->prev;
+        pos->prev->next = node;
+        pos->prev = node;
+    }
+
+    void reset() { sentinel.prev = sentinel.next = &sentinel; }
+public:
+
+#ifdef USE_ITERATORS
+    class iterator {
+        Hook * node{nullptr};
+        iterator(Hook * node) { this->node = node; }
+        friend class IntrusiveList;
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        inline T & operator*() const { return value(node); }
+        inline T * operator->() const { return &value(node); }
+        inline iterator & operator++() { node = node->next; return *this; } // pre
+        inline iterator & operator--() { node = node->prev; return *this; } // pre
+        inline iterator operator++(int) { auto tmp = iterator(*this); node = node->next; return tmp; } // post
+        inline iterator operator--(int) { auto tmp = iterator(*this); node = node->prev; return tmp; } // post
+        inline bool operator==(const iterator & other) const { return this->node == other.node; }
+        inline bool operator!=(const iterator & other) const { return !(*this == other); }
+    };
+
+    iterator begin() { return iterator(sentinel.next); }
+    iterator end() { return iterator(&sentinel); }
+    /// @brief Iterator pointing at item, which must be on this list.
+    static iterator iterator_to(T & item) { return iterator(hook(item)); }
+
+    /// @brief Links item in front of pos.
+    iterator insert(iterator pos, T & item) {
+        link_before(pos.node, hook(item));
+        return iterator(hook(item));
+    }
+    /// @brief Unlinks the object at pos, returns the following position.
+    iterator erase(iterator pos) {
+        Hook * next = pos.node->next;
+        pos.node->unlink();
+        return iterator(next);
+    }
+#endif // USE_ITERATORS
+
+    IntrusiveList() { reset(); }
+    IntrusiveList(const IntrusiveList &) = delete;
+    IntrusiveList & operator=(const IntrusiveList &) = delete;
+    IntrusiveList(IntrusiveList && other) {
+        reset();
+        splice_back(other);
+    }
+    IntrusiveList & operator=(IntrusiveList && other) {
+        if(this != &other) {
+            clear();
+            splice_back(other);
+        }
+        return *this;
+    }
+    ~IntrusiveList() {
+        clear();
+        // The sentinel is not on any list, keep its destructor from touching it.
+        sentinel.prev = sentinel.next = nullptr;
+    }
+
+    void push_front(T & item) { link_before(sentinel.next, hook(item)); }
+    void push_back(T & item) { link_before(&sentinel, hook(item)); }
+
+    /// @brief Unlinks the first object, it is not destroyed.
+    void pop_front() { assert( ! empty() ); sentinel.next->unlink(); }
+    /// @brief Unlinks the last object, it is not destroyed.
+    void pop_back() { assert( ! empty() ); sentinel.prev->unlink(); }
+
+    /// @brief Unlinks item from the list of this Tag holding it, O(1).
+    static void remove(T & item) { hook(item)->unlink(); }
+
+    /// @brief Moves all objects of other to the back of this list, O(1).
+    void splice_back(IntrusiveList & other) {
+        if(other.empty()) return;
+        Hook * first = other.sentinel.next;
+        Hook * last = other.sentinel.prev;
+        other.reset();
+        first->prev = sentinel.prev;
+        sentinel.prev->next = first;
+        last->next = &sentinel;
+        sentinel.prev = last;
+    }
+
+    bool empty() const { return sentinel.next == &sentinel; }
+    size_t size() const {
+        size_t count{0};
+        for(const Hook * node = sentinel.next; node != &sentinel; node = node->next) count++;
+        return count;
+    }
+
+    T & front() { return value(sentinel.next); }
+    const T & front() const { return value(const_cast<Hook *>(sentinel.next)); }
+    T & back() { return value(sentinel.prev); }
+    const T & back() const { return value(const_cast<Hook *>(sentinel.prev)); }
+
+    /// @brief Unlinks all objects.
+    void clear() {
+        Hook * node = sentinel.next;
+        while(node != &sentinel) {
+            Hook * next = node->next;
+            node->prev = node->next = nullptr;
+            node = next;
+        }
+        reset();
+    }
+};
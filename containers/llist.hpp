@@ -19,6 +19,12 @@ Containers. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "container_stats.hpp"
 
 #ifdef USE_ITERATORS
     #include <iterator>
@@ -26,28 +32,95 @@ Containers. If not, see <https://www.gnu.org/licenses/>.
 #endif
 
 
-template<class T>
+/// Doubly linked list. Nodes come from Allocator rebound to the node type,
+/// see node_pool.hpp for allocators which avoid the global heap.
+/// Stats selects instrumentation, e.g. CountingStats, see stats().
+template<class T, class Allocator = std::allocator<T>, class Stats = NoStats>
 class LList {
     struct Node {
         T value;
         Node * prev{nullptr};
         Node * next{nullptr};
+        template<class... Args>
+        Node(Args &&... args) : value(std::forward<Args>(args)...) {}
     };
+    using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
     Node * head{nullptr};
     Node * tail{nullptr};
+    size_t count{0};
+    [[no_unique_address]] NodeAllocator alloc;
+    [[no_unique_address]] Stats counters;
+
+    template<class... Args>
+    Node * create_node(Args &&... args) {
+        Node * node;
+        if constexpr (Stats::enabled) {
+            try {
+                node = NodeTraits::allocate(alloc, 1);
+            } catch(...) {
+                counters.dropped();
+                throw;
+            }
+        } else node = NodeTraits::allocate(alloc, 1);
+        counters.allocated();
+        return ::new (node) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy_node(Node * node) {
+        node->~Node();
+        NodeTraits::deallocate(alloc, node, 1);
+        counters.deallocated();
+    }
+
+    /// @brief Links node in front of pos, at the back when pos is nullptr.
+    void link_before(Node * pos, Node * node) {
+        link_before(pos, node, node, 1);
+    }
+    /// @brief Links the chain first..last of n nodes in front of pos, at the back when pos is nullptr.
+    void link_before(Node * pos, Node * first, Node * last, size_t n) {
+        Node * prev = pos ? pos->prev : tail;
+        first->prev = prev;
+        last->next = pos;
+        if(prev) prev->next = first;
+        else head = first;
+        if(pos) pos->prev = last;
+        else tail = last;
+        count += n;
+        counters.pushed(n, count);
+    }
+    /// @brief Cuts the chain first..last of n nodes out of this list.
+    void unlink(Node * first, Node * last, size_t n) {
+        if(first->prev) first->prev->next = last->next;
+        else head = last->next;
+        if(last->next) last->next->prev = first->prev;
+        else tail = first->prev;
+        first->prev = last->next = nullptr;
+        count -= n;
+        counters.popped(n);
+    }
+
+    /// @brief Nodes may only change lists when either allocator can free them.
+    bool shares_allocator(const LList & other) const {
+        if constexpr (NodeTraits::is_always_equal::value) return true;
+        else return alloc == other.alloc;
+    }
 public:
 
 #ifdef USE_ITERATORS 
-    class iterator : public std::iterator<
-                                std::bidirectional_iterator_tag,
-                                T,
-                                size_t,
-                                T*,
-                                T> {
+    class iterator {
         Node * node{nullptr};
         iterator(Node * node) { this->node = node; }
         friend class LList;
     public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
         inline T & operator*() { assert(node); return node->value; }
         inline iterator & operator++() { assert(node); node = node->next; return *this; } // pre
         inline iterator & operator--() { assert(node); node = node->prev; return *this; } // pre
@@ -76,35 +149,122 @@ public:
     iterator end() const { return iterator(nullptr); }
     const_iterator const_begin() const { return const_iterator(head); }
     const_iterator const_end() const { return const_iterator(nullptr); }
+
+    /// @brief Constructs an element in front of pos, returns its position.
+    template<class... Args>
+    iterator emplace(iterator pos, Args &&... args) {
+        Node * node = create_node(std::forward<Args>(args)...);
+        link_before(pos.node, node);
+        return iterator(node);
+    }
+    iterator insert(iterator pos, const T & item) { return emplace(pos, item); }
+    iterator insert(iterator pos, T && item) { return emplace(pos, std::move(item)); }
+
+    /// @brief Destroys the element at pos, returns the following position.
+    iterator erase(iterator pos) {
+        assert(pos.node);
+        Node * next = pos.node->next;
+        unlink(pos.node, pos.node, 1);
+        destroy_node(pos.node);
+        return iterator(next);
+    }
+    /// @brief Destroys the elements in [first, last), returns last.
+    iterator erase(iterator first, iterator last) {
+        while(first != last) first = erase(first);
+        return last;
+    }
+
+    /// @brief Moves all elements of other in front of pos without reallocating nodes, O(1).
+    /// The allocators must compare equal.
+    void splice(iterator pos, LList & other) {
+        if(this == &other || other.empty()) return;
+        assert(shares_allocator(other));
+        Node * first = other.head;
+        Node * last = other.tail;
+        const size_t n = other.count;
+        other.unlink(first, last, n);
+        link_before(pos.node, first, last, n);
+    }
+    /// @brief Moves the element at it from other in front of pos, O(1).
+    void splice(iterator pos, LList & other, iterator it) {
+        assert(it.node && shares_allocator(other));
+        if(it == pos) return;
+        other.unlink(it.node, it.node, 1);
+        link_before(pos.node, it.node);
+    }
+    /// @brief Moves the n elements [first, last) from other in front of pos, O(1).
+    /// pos must not lie inside the range when other is this list.
+    void splice(iterator pos, LList & other, iterator first, iterator last, size_t n) {
+        if(n == 0) return;
+        assert(shares_allocator(other));
+        Node * last_node = last.node ? last.node->prev : other.tail;
+        other.unlink(first.node, last_node, n);
+        link_before(pos.node, first.node, last_node, n);
+    }
+    /// @brief As above, counting the range first, O(n) in its length.
+    void splice(iterator pos, LList & other, iterator first, iterator last) {
+        size_t n{0};
+        for(iterator it = first; it != last; ++it) n++;
+        splice(pos, other, first, last, n);
+    }
 #endif // USE_ITERATORS
 
     LList(const LList &) = delete;
     LList & operator=(const LList &) = delete;
     LList() {}
     LList(std::initializer_list<T> list) {
-        for(auto value : list) push_back(value);
+        for(const auto & value : list) push_back(value);
+    }
+
+    /// Nodes are taken over when the allocators are interchangeable,
+    /// otherwise elements are moved one by one into nodes of this list.
+    LList(LList && other) {
+        take(other);
+    }
+    LList & operator=(LList && other) {
+        if(this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
     }
 
-    void push_front(const T & item) {
-        Node * node = new Node{item, nullptr, nullptr};
+    template<class... Args>
+    T & emplace_front(Args &&... args) {
+        Node * node = create_node(std::forward<Args>(args)...);
         if( ! head ) { head = tail = node; }
         else { head->prev = node; node->next = head; head = node; }
+        count++;
+        counters.pushed(1, count);
         assert(head == node);
+        return node->value;
     }
 
-    void push_back(const T & item) {
-        Node * node = new Node{item, nullptr, nullptr};
+    template<class... Args>
+    T & emplace_back(Args &&... args) {
+        Node * node = create_node(std::forward<Args>(args)...);
         if( ! tail ) { head = tail = node; }
         else { tail->next = node; node->prev = tail; tail = node; }
+        count++;
+        counters.pushed(1, count);
         assert(tail == node);
+        return node->value;
     }
+
+    void push_front(const T & item) { emplace_front(item); }
+    void push_front(T && item) { emplace_front(std::move(item)); }
+    void push_back(const T & item) { emplace_back(item); }
+    void push_back(T && item) { emplace_back(std::move(item)); }
         
     void pop_front() {
         assert(head);
         Node * tmp = head;
         head = head->next;
         if( !head ) tail = nullptr;
-        delete tmp;
+        else head->prev = nullptr;
+        count--;
+        counters.popped(1);
+        destroy_node(tmp);
     }
 
     void pop_back() {
@@ -112,22 +272,64 @@ public:
         Node * tmp = tail;
         tail = tail->prev;
         if( !tail ) head = nullptr;
-        delete tmp;
+        else tail->next = nullptr;
+        count--;
+        counters.popped(1);
+        destroy_node(tmp);
     }
 
-    bool empty() {
+    bool empty() const {
         assert( (!head) == (!tail) );
         return head == nullptr;
     }
+    size_t size() const { return count; }
+
+    /// @brief Counters collected by Stats (all zero with NoStats) and the current size.
+    ContainerStats stats() const {
+        ContainerStats snapshot = counters.snapshot();
+        snapshot.size = count;
+        return snapshot;
+    }
+
+    const NodeAllocator & get_allocator() const { return alloc; }
 
+    T & front() { return head->value; }
     const T & front() const { return head->value; }
+    T & back() { return tail->value; }
     const T & back() const { return tail->value; }
 
+    /// @brief Destroys all elements in one pass over the nodes.
     void clear() {
-        while(!empty()) pop_back();
+        counters.popped(count);
+        Node * node = head;
+        while(node) {
+            Node * next = node->next;
+            destroy_node(node);
+            node = next;
+        }
+        head = tail = nullptr;
+        count = 0;
     }
 
     ~LList() {
         clear();
     }
+
+private:
+    void take(LList & other) {
+        if constexpr (NodeTraits::is_always_equal::value) {
+            head = other.head;
+            tail = other.tail;
+            count = other.count;
+            counters.pushed(count, count);
+            other.counters.popped(other.count);
+            other.head = other.tail = nullptr;
+            other.count = 0;
+        } else {
+            while( ! other.empty() ) {
+                push_back(std::move(other.front()));
+                other.pop_front();
+            }
+        }
+    }
 };
@@ -0,0 +1,170 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+/// Heap-backed ring buffer whose storage is mapped twice, back to back.
+///
+/// Slot i and slot i + capacity() are the same memory, so the contents and
+/// the free space are always single contiguous spans, no matter where the
+/// wrap point is. They can be passed straight to write(), memcmp or a parser.
+/// Capacity is chosen at runtime and rounded up so that the mapping is a whole
+/// number of pages. Like Ringbuffer::push_back, pushing into a full buffer
+/// overwrites the oldest element. Linux only (memfd_create).
+template<class T>
+class MirroredRingbuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "elements live in shared pages, T must be trivially copyable");
+
+    T *m_data{nullptr};
+    size_t m_capacity{0};
+    size_t m_head{0};
+    size_t m_size{0};
+
+    [[noreturn]] static void fail(const char * what) {
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    static size_t mapping_bytes(size_t min_capacity) {
+        const long page = sysconf(_SC_PAGESIZE);
+        if(page <= 0) fail("sysconf");
+        const size_t unit = std::lcm((size_t)page, sizeof(T));
+        const size_t bytes = std::max(min_capacity, (size_t)1) * sizeof(T);
+        return (bytes + unit - 1) / unit * unit;
+    }
+
+    void map(size_t bytes) {
+        const int fd = memfd_create("ringbuffer", MFD_CLOEXEC);
+        if(fd < 0) fail("memfd_create");
+        if(ftruncate(fd, (off_t)bytes) != 0) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "ftruncate");
+        }
+        // Reserve both halves first, so nothing else can be mapped in between.
+        void *base = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(base == MAP_FAILED) {
+            const int error = errno;
+            close(fd);
+            throw std::system_error(error, std::system_category(), "mmap");
+        }
+        char *bytes_base = static_cast<char *>(base);
+        for(char *half : {bytes_base, bytes_base + bytes}) {
+            if(mmap(half, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                const int error = errno;
+                munmap(base, 2 * bytes);
+                close(fd);
+                throw std::system_error(error, std::system_category(), "mmap");
+            }
+        }
+        // The mappings keep the memory alive, the descriptor is not needed anymore.
+        close(fd);
+        m_data = static_cast<T *>(base);
+        m_capacity = bytes / sizeof(T);
+    }
+
+    void unmap() {
+        if(m_data) munmap(m_data, 2 * m_capacity * sizeof(T));
+        m_data = nullptr;
+    }
+
+    size_t tail() const {
+        const size_t tail = m_head + m_size;
+        return tail >= m_capacity ? tail - m_capacity : tail;
+    }
+
+public:
+    /// @brief Capacity is at least min_capacity, rounded up to whole pages.
+    /// @throws std::system_error when the mapping cannot be set up.
+    explicit MirroredRingbuffer(size_t min_capacity) { map(mapping_bytes(min_capacity)); }
+    MirroredRingbuffer(const MirroredRingbuffer &) = delete;
+    MirroredRingbuffer & operator=(const MirroredRingbuffer &) = delete;
+    MirroredRingbuffer(MirroredRingbuffer && other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_capacity(std::exchange(other.m_capacity, 0)),
+          m_head(std::exchange(other.m_head, 0)), m_size(std::exchange(other.m_size, 0)) {}
+    MirroredRingbuffer & operator=(MirroredRingbuffer && other) noexcept {
+        if(this != &other) {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_head = std::exchange(other.m_head, 0);
+            m_size = std::exchange(other.m_size, 0);
+        }
+        return *this;
+    }
+    ~MirroredRingbuffer() { unmap(); }
+
+    /// @brief Appends item, overwriting the oldest element when full.
+    void push_back(const T & item) {
+        m_data[tail()] = item;
+        if(full()) consume(1);
+        m_size++;
+    }
+    /// @brief Appends all items, the oldest elements are overwritten when they do not fit.
+    void push_back(std::span<const T> items) {
+        if(items.size() > m_capacity) items = items.last(m_capacity);
+        const size_t overflow = m_size + items.size() > m_capacity ? m_size + items.size() - m_capacity : 0;
+        std::memcpy(m_data + tail(), items.data(), items.size() * sizeof(T));
+        consume(overflow);
+        m_size += items.size();
+    }
+
+    T & front() { return m_data[m_head]; }
+    const T & front() const { return m_data[m_head]; }
+    T & back() { return m_data[m_head + m_size - 1]; }
+    const T & back() const { return m_data[m_head + m_size - 1]; }
+    T & operator[](size_t idx) { return m_data[m_head + idx]; }
+    const T & operator[](size_t idx) const { return m_data[m_head + idx]; }
+
+    void pop_front() { consume(1); }
+    /// @brief Drops count elements from the front, at most size().
+    void consume(size_t count) {
+        count = std::min(count, m_size);
+        m_head += count;
+        if(m_head >= m_capacity) m_head -= m_capacity;
+        m_size -= count;
+    }
+    void clear() { m_head = 0; m_size = 0; }
+
+    /// @brief All elements, front to back, as one contiguous span.
+    std::span<T> read_span() { return { m_data + m_head, m_size }; }
+    std::span<const T> read_span() const { return { m_data + m_head, m_size }; }
+    /// @brief Free slots after the back as one contiguous span. Fill a prefix and
+    /// publish it with commit().
+    std::span<T> write_span() { return { m_data + tail(), m_capacity - m_size }; }
+    /// @brief Appends count elements previously written through write_span().
+    void commit(size_t count) { m_size += std::min(count, m_capacity - m_size); }
+
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == m_capacity; }
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+};
@@ -0,0 +1,128 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "cache_line.hpp"
+#include "hazard_pointers.hpp"
+
+/// Unbounded lock-free queue for any number of producer and consumer threads
+/// (Michael and Scott's queue).
+///
+/// Nodes are linked like LList nodes, one allocation per element, with a dummy
+/// node in front. Consumers free the dummy they dequeue past through
+/// HazardPointers, so a node is never freed while another thread reads it.
+template<class T>
+class MpmcListQueue {
+    struct Node {
+        std::atomic<Node *> next{nullptr};
+        // Alive from push until the consumer which dequeues it moves it out.
+        union { T value; };
+        Node() {}
+        template<class... Args>
+        Node(std::in_place_t, Args &&... args) : value(std::forward<Args>(args)...) {}
+        ~Node() {}
+    };
+
+    static void delete_node(void * node) { delete static_cast<Node *>(node); }
+
+    alignas(cache_line_size) std::atomic<Node *> m_head;
+    alignas(cache_line_size) std::atomic<Node *> m_tail;
+
+public:
+    MpmcListQueue() {
+        Node * dummy = new Node();
+        m_head.store(dummy, std::memory_order_relaxed);
+        m_tail.store(dummy, std::memory_order_relaxed);
+    }
+    MpmcListQueue(const MpmcListQueue &) = delete;
+    MpmcListQueue & operator=(const MpmcListQueue &) = delete;
+    /// No other thread may use the queue anymore.
+    ~MpmcListQueue() {
+        Node * node = m_head.load(std::memory_order_relaxed);
+        Node * next = node->next.load(std::memory_order_relaxed);
+        delete node;
+        while(next) {
+            node = next;
+            next = node->next.load(std::memory_order_relaxed);
+            std::destroy_at(&node->value);
+            delete node;
+        }
+    }
+
+    template<class... Args>
+    void emplace(Args &&... args) {
+        Node * node = new Node(std::in_place, std::forward<Args>(args)...);
+        for(;;) {
+            Node * tail = HazardPointers::protect(0, m_tail);
+            Node * next = tail->next.load(std::memory_order_acquire);
+            if(tail != m_tail.load(std::memory_order_acquire)) continue;
+            if(next) { // help a producer which linked but did not swing the tail yet
+                m_tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if(tail->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+                m_tail.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+                break;
+            }
+        }
+        HazardPointers::clear(0);
+    }
+    void push(const T & item) { emplace(item); }
+    void push(T && item) { emplace(std::move(item)); }
+
+    /// @brief Moves the oldest element into item, returns false when empty.
+    bool try_pop(T & item) {
+        for(;;) {
+            Node * head = HazardPointers::protect(0, m_head);
+            Node * tail = m_tail.load(std::memory_order_acquire);
+            Node * next = HazardPointers::protect(1, head->next);
+            if(head != m_head.load(std::memory_order_acquire)) continue;
+            if( ! next ) {
+                HazardPointers::clear(0);
+                HazardPointers::clear(1);
+                return false;
+            }
+            if(head == tail) {
+                m_tail.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if(m_head.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                // next is the new dummy, protected until its value is moved out.
+                item = std::move(next->value);
+                std::destroy_at(&next->value);
+                HazardPointers::clear(0);
+                HazardPointers::clear(1);
+                HazardPointers::retire(head, &delete_node);
+                return true;
+            }
+        }
+    }
+
+    /// @brief Snapshot, may be outdated by the time it is used.
+    bool empty() const {
+        Node * head = HazardPointers::protect(0, m_head);
+        const bool result = head->next.load(std::memory_order_acquire) == nullptr;
+        HazardPointers::clear(0);
+        return result;
+    }
+};
@@ -0,0 +1,126 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "cache_line.hpp"
+
+/// Bounded lock-free queue for any number of producer and consumer threads.
+///
+/// Storage is a fixed array of N slots like Ringbuffer, each slot carrying a
+/// sequence number (D. Vyukov's bounded MPMC queue). A producer and a consumer
+/// only contend when they race for the same slot, never on a shared lock.
+/// N must be a power of two. push/pop block with std::atomic::wait on the slot
+/// they are waiting for, try_push/try_pop never block.
+template<class T, size_t N>
+class MpmcQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpmcQueue capacity must be a power of two");
+    static constexpr size_t mask = N - 1;
+
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    alignas(cache_line_size) std::atomic<size_t> m_enqueue{0};
+    alignas(cache_line_size) std::atomic<size_t> m_dequeue{0};
+    alignas(cache_line_size) Slot m_data[N];
+
+    template<bool Blocking, class U>
+    bool push_impl(U && item) {
+        size_t pos = m_enqueue.load(std::memory_order_relaxed);
+        for(;;) {
+            Slot & slot = m_data[pos & mask];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if(diff == 0) {
+                if(m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::forward<U>(item);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    slot.sequence.notify_all();
+                    return true;
+                }
+            } else if(diff < 0) { // slot still holds an element from the previous lap
+                if constexpr ( ! Blocking ) return false;
+                slot.sequence.wait(seq, std::memory_order_acquire);
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            } else {
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template<bool Blocking>
+    bool pop_impl(T & item) {
+        size_t pos = m_dequeue.load(std::memory_order_relaxed);
+        for(;;) {
+            Slot & slot = m_data[pos & mask];
+            const size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if(diff == 0) {
+                if(m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = std::move(slot.value);
+                    slot.sequence.store(pos + N, std::memory_order_release);
+                    slot.sequence.notify_all();
+                    return true;
+                }
+            } else if(diff < 0) { // slot not yet written for this lap
+                if constexpr ( ! Blocking ) return false;
+                slot.sequence.wait(seq, std::memory_order_acquire);
+                pos = m_dequeue.load(std::memory_order_relaxed);
+            } else {
+                pos = m_dequeue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    MpmcQueue() {
+        for(size_t i = 0; i < N; ++i) m_data[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    MpmcQueue(const MpmcQueue &) = delete;
+    MpmcQueue & operator=(const MpmcQueue &) = delete;
+
+    /// @brief Returns false when the queue is full.
+    bool try_push(const T & item) { return push_impl<false>(item); }
+    bool try_push(T && item) { return push_impl<false>(std::move(item)); }
+
+    /// @brief Returns false when the queue is empty.
+    bool try_pop(T & item) { return pop_impl<false>(item); }
+
+    /// @brief Waits while the queue is full.
+    void push(const T & item) { push_impl<true>(item); }
+    void push(T && item) { push_impl<true>(std::move(item)); }
+
+    /// @brief Waits while the queue is empty.
+    void pop(T & item) { pop_impl<true>(item); }
+
+    // Snapshot only, may be outdated as soon as it returns.
+    size_t size() const {
+        const size_t dequeue = m_dequeue.load(std::memory_order_acquire);
+        const size_t enqueue = m_enqueue.load(std::memory_order_acquire);
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+    bool empty() const { return size() == 0; }
+    constexpr size_t capacity() const { return N; }
+};
@@ -0,0 +1,95 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "cache_line.hpp"
+
+/// Unbounded lock-free queue for any number of producer threads and a single
+/// consumer thread (D. Vyukov's intrusive MPSC queue).
+///
+/// A push is one atomic exchange and never waits for other producers. Nodes are
+/// linked like LList nodes, one allocation per element. Only the consumer frees
+/// nodes and producers never touch a node after linking it, so no reclamation
+/// scheme is needed. A producer preempted between its exchange and its link
+/// hides elements pushed after it from the consumer until it resumes;
+/// try_pop then reports empty.
+template<class T>
+class MpscListQueue {
+    struct Node {
+        std::atomic<Node *> next{nullptr};
+        union { T value; };
+        Node() {}
+        template<class... Args>
+        Node(std::in_place_t, Args &&... args) : value(std::forward<Args>(args)...) {}
+        ~Node() {}
+    };
+
+    // Producers exchange the newest node in.
+    alignas(cache_line_size) std::atomic<Node *> m_head;
+    // The consumer's stub, its successor holds the oldest element.
+    alignas(cache_line_size) Node * m_tail;
+
+public:
+    MpscListQueue() {
+        Node * stub = new Node();
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+    MpscListQueue(const MpscListQueue &) = delete;
+    MpscListQueue & operator=(const MpscListQueue &) = delete;
+    /// No other thread may use the queue anymore.
+    ~MpscListQueue() {
+        Node * next = m_tail->next.load(std::memory_order_relaxed);
+        delete m_tail;
+        while(next) {
+            Node * node = next;
+            next = node->next.load(std::memory_order_relaxed);
+            std::destroy_at(&node->value);
+            delete node;
+        }
+    }
+
+    /// @brief Producer side, any thread.
+    template<class... Args>
+    void emplace(Args &&... args) {
+        Node * node = new Node(std::in_place, std::forward<Args>(args)...);
+        Node * prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+    void push(const T & item) { emplace(item); }
+    void push(T && item) { emplace(std::move(item)); }
+
+    /// @brief Consumer side. Moves the oldest element into item, returns false when empty.
+    bool try_pop(T & item) {
+        Node * next = m_tail->next.load(std::memory_order_acquire);
+        if( ! next ) return false;
+        item = std::move(next->value);
+        std::destroy_at(&next->value);
+        delete m_tail;
+        m_tail = next;
+        return true;
+    }
+
+    /// @brief Consumer side.
+    bool empty() const { return m_tail->next.load(std::memory_order_acquire) == nullptr; }
+};
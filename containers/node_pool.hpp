@@ -0,0 +1,130 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+
+/// Fixed capacity allocator for single objects, e.g. LList nodes.
+///
+/// All Capacity slots live inside the allocator object itself, freed slots are
+/// kept on an intrusive free list, so it never calls the global allocator.
+/// A container owns its own pool, so it cannot be copied and two pools only
+/// compare equal to themselves. That rules out containers which copy their
+/// allocator; LList and UnrolledLList default construct the rebound one.
+/// Throws std::bad_alloc when exhausted.
+template<class T, size_t Capacity>
+class PoolAllocator {
+    union Slot {
+        Slot * next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    Slot m_slots[Capacity];
+    Slot * m_free{nullptr};
+    size_t m_used{0};
+public:
+    using value_type = T;
+    template<class U> struct rebind { using other = PoolAllocator<U, Capacity>; };
+
+    PoolAllocator() {}
+    PoolAllocator(const PoolAllocator &) = delete;
+    PoolAllocator & operator=(const PoolAllocator &) = delete;
+
+    T * allocate(size_t n) {
+        assert(n == 1);
+        Slot * slot = m_free;
+        if(slot) m_free = slot->next;
+        else if(m_used < Capacity) slot = &m_slots[m_used++];
+        else throw std::bad_alloc();
+        return reinterpret_cast<T *>(slot->storage);
+    }
+    void deallocate(T * ptr, size_t) {
+        Slot * slot = reinterpret_cast<Slot *>(ptr);
+        slot->next = m_free;
+        m_free = slot;
+    }
+    constexpr size_t capacity() const { return Capacity; }
+
+    bool operator==(const PoolAllocator & other) const { return this == &other; }
+};
+
+/// Growable allocator for single objects, carving them from slabs of SlabSize.
+///
+/// Freed objects go to an intrusive free list and are reused before a new slab
+/// is requested, so a container at steady state does not touch the global
+/// allocator. Slabs are only released when the allocator is destroyed.
+/// Not copyable either, like PoolAllocator.
+template<class T, size_t SlabSize = 64>
+class SlabAllocator {
+    union Slot {
+        Slot * next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    struct Slab {
+        Slab * next;
+        Slot slots[SlabSize];
+    };
+    Slab * m_slabs{nullptr};
+    Slot * m_free{nullptr};
+    size_t m_used{SlabSize};
+    size_t m_slab_count{0};
+public:
+    using value_type = T;
+    template<class U> struct rebind { using other = SlabAllocator<U, SlabSize>; };
+
+    SlabAllocator() {}
+    SlabAllocator(const SlabAllocator &) = delete;
+    SlabAllocator & operator=(const SlabAllocator &) = delete;
+
+    ~SlabAllocator() {
+        while(m_slabs) {
+            Slab * tmp = m_slabs;
+            m_slabs = m_slabs->next;
+            delete tmp;
+        }
+    }
+
+    T * allocate(size_t n) {
+        assert(n == 1);
+        Slot * slot = m_free;
+        if(slot) {
+            m_free = slot->next;
+        } else {
+            if(m_used == SlabSize) {
+                Slab * slab = new Slab;
+                slab->next = m_slabs;
+                m_slabs = slab;
+                m_used = 0;
+                m_slab_count++;
+            }
+            slot = &m_slabs->slots[m_used++];
+        }
+        return reinterpret_cast<T *>(slot->storage);
+    }
+    void deallocate(T * ptr, size_t) {
+        Slot * slot = reinterpret_cast<Slot *>(ptr);
+        slot->next = m_free;
+        m_free = slot;
+    }
+    size_t slab_count() const { return m_slab_count; }
+
+    bool operator==(const SlabAllocator & other) const { return this == &other; }
+};
@@ -0,0 +1,158 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "cache_line.hpp"
+#include "spsc_ringbuffer.hpp"
+
+/// SpscRingbuffer whose consumer can block in wait() instead of polling.
+///
+/// The consumer spins for a while, then sleeps on an atomic (a futex on Linux).
+/// The producer only notifies when the consumer sleeps and the buffer holds at
+/// least watermark elements, so pushes into a buffer which is being drained, or
+/// which is still below the watermark, never make a syscall; a consumer with a
+/// watermark above 1 wakes up once per batch. flush() wakes it below the
+/// watermark, e.g. at the end of a burst.
+/// The spin budget adapts: it grows when data arrived while spinning and
+/// shrinks when the consumer had to sleep anyway.
+template<class T, size_t N>
+class NotifyingRingbuffer {
+public:
+    static constexpr unsigned min_spins = 16;
+    static constexpr unsigned max_spins = 4096;
+
+private:
+    SpscRingbuffer<T, N> m_ring;
+    const size_t m_watermark;
+
+    // Bumped by the producer on every notification, the consumer sleeps on it.
+    alignas(cache_line_size) std::atomic<uint32_t> m_epoch{0};
+    std::atomic<bool> m_flushed{false};
+    uint64_t m_notifications{0};
+
+    // Set by the consumer before it sleeps, cleared by whoever wakes it.
+    alignas(cache_line_size) std::atomic<uint32_t> m_sleeping{0};
+    unsigned m_spins{256};
+
+    static void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+
+    void notify(bool force) {
+        // Pairs with the fence in wait(): either the consumer sees the new tail or we see it sleeping.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if( ! m_sleeping.load(std::memory_order_relaxed) ) return;
+        if( ! force && m_ring.size() < m_watermark ) return;
+        if( ! m_sleeping.exchange(0, std::memory_order_relaxed) ) return;
+        m_epoch.fetch_add(1, std::memory_order_release);
+        m_epoch.notify_one();
+        m_notifications++;
+    }
+
+    bool ready() {
+        if(m_ring.size() >= m_watermark) return true;
+        return m_flushed.load(std::memory_order_relaxed) && m_flushed.exchange(false, std::memory_order_acquire);
+    }
+
+public:
+    /// @brief watermark is the fill level at which a sleeping consumer is woken, 1 to N - 1.
+    explicit NotifyingRingbuffer(size_t watermark = 1) : m_watermark(watermark) {
+        assert(watermark >= 1 && watermark <= m_ring.capacity());
+    }
+    NotifyingRingbuffer(const NotifyingRingbuffer &) = delete;
+    NotifyingRingbuffer & operator=(const NotifyingRingbuffer &) = delete;
+
+    /// @brief Producer side. Returns false when full, wakes the consumer if needed.
+    bool try_push(const T & item) {
+        if( ! m_ring.try_push(item) ) return false;
+        notify(false);
+        return true;
+    }
+    bool try_push(T && item) {
+        if( ! m_ring.try_push(std::move(item)) ) return false;
+        notify(false);
+        return true;
+    }
+    /// @brief Producer side. Wakes a sleeping consumer even below the watermark.
+    void flush() {
+        m_flushed.store(true, std::memory_order_release);
+        notify(true);
+    }
+    /// @brief Producer side. Number of times a sleeping consumer was woken.
+    uint64_t notifications() const { return m_notifications; }
+    /// @brief Producer side. True once the consumer gave up spinning and is
+    /// blocked in wait(), until it is woken.
+    bool sleeping() const { return m_sleeping.load(std::memory_order_acquire); }
+
+    /// @brief Consumer side. Blocks until at least watermark elements are
+    /// available or the producer called flush() since the last wait() returned.
+    /// Returns the number available, which may be 0 after a flush().
+    size_t wait() {
+        for(unsigned spin = 0; spin < m_spins; ++spin) {
+            if(ready()) {
+                m_spins = std::min(m_spins * 2, max_spins);
+                return m_ring.size();
+            }
+            cpu_relax();
+        }
+        m_spins = std::max(m_spins / 2, min_spins);
+        while(true) {
+            const uint32_t epoch = m_epoch.load(std::memory_order_acquire);
+            m_sleeping.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(ready()) {
+                m_sleeping.store(0, std::memory_order_relaxed);
+                return m_ring.size();
+            }
+            // Returns once a notification changed the epoch, also if that happened since it was read.
+            m_epoch.wait(epoch, std::memory_order_acquire);
+        }
+    }
+
+    /// @brief Consumer side. Moves the oldest element into item, returns false when empty.
+    bool try_pop(T & item) { return m_ring.try_pop(item); }
+    /// @brief Consumer side. Passes every available element to f, returns how many.
+    template<class F>
+    size_t drain(F && f) {
+        size_t count = 0;
+        while(T * item = m_ring.front()) {
+            f(*item);
+            m_ring.pop_front();
+            count++;
+        }
+        return count;
+    }
+
+    bool empty() const { return m_ring.empty(); }
+    size_t size() const { return m_ring.size(); }
+    constexpr size_t capacity() const { return m_ring.capacity(); }
+    size_t watermark() const { return m_watermark; }
+};
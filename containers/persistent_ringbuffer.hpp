@@ -0,0 +1,200 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "cache_line.hpp"
+
+/// Start of a PersistentRingbuffer file. It does not depend on the element
+/// type, so tools can read any such file, see tools/flight_recorder.cpp.
+struct PersistentRingbufferHeader {
+    static constexpr uint32_t magic_value = 0x46504252; // "RBPF"
+    static constexpr uint32_t current_version = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t element_size;
+    uint64_t capacity;
+    uint64_t data_offset;
+    // Free running element counters, the elements are [head, tail).
+    alignas(cache_line_size) std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+
+    /// @brief Whether the header is intact and its elements fit into a file of file_bytes.
+    bool valid(size_t file_bytes) const {
+        if(file_bytes < sizeof(PersistentRingbufferHeader)) return false;
+        const uint64_t first = head.load(std::memory_order_acquire);
+        const uint64_t last = tail.load(std::memory_order_acquire);
+        return magic == magic_value && version == current_version
+            && element_size > 0 && capacity > 0
+            && data_offset >= sizeof(PersistentRingbufferHeader)
+            && data_offset <= file_bytes
+            && (file_bytes - data_offset) / element_size >= capacity
+            && first <= last && last - first <= capacity;
+    }
+};
+
+/// Ringbuffer whose head, tail and storage live in a memory mapped file, so
+/// the last N elements survive the process dying and can be read back after
+/// a restart or by another process (a flight recorder).
+///
+/// push_back costs the same as Ringbuffer's: a copy into the mapping and two
+/// counter stores. The element is copied before tail is advanced and head is
+/// advanced before an element is overwritten, so whenever the process dies
+/// [head, tail) only holds complete elements. Surviving a power loss in
+/// addition needs sync(). One process (and thread) may write at a time, the
+/// ordering is only kept against the writer dying, so read the file once the
+/// writer is gone rather than concurrently.
+template<class T, size_t N>
+class PersistentRingbuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "elements are stored in a file, T must be trivially copyable");
+    static_assert(N > 0);
+
+public:
+    using Header = PersistentRingbufferHeader;
+
+private:
+    static constexpr size_t data_align = std::max(alignof(T), cache_line_size);
+    static constexpr uint64_t data_offset = (sizeof(Header) + data_align - 1) / data_align * data_align;
+    static constexpr size_t file_bytes = data_offset + N * sizeof(T);
+
+    Header *m_header{nullptr};
+    T *m_data{nullptr};
+
+    [[noreturn]] static void fail(int error, const char * what) {
+        throw std::system_error(error, std::system_category(), what);
+    }
+
+    explicit PersistentRingbuffer(void * map)
+        : m_header(static_cast<Header *>(map)),
+          m_data(reinterpret_cast<T *>(static_cast<char *>(map) + data_offset)) {}
+
+public:
+    /// @brief Maps the file at path, keeping the elements of a previous run.
+    /// A missing, empty or never initialised file is created and initialised.
+    /// @throws std::system_error, with std::errc::invalid_argument when the file
+    /// holds another element type, capacity or layout version, or is damaged.
+    static PersistentRingbuffer open(const char * path) {
+        const int fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if(fd < 0) fail(errno, "open");
+        struct stat st;
+        if(fstat(fd, &st) != 0 || (st.st_size == 0 && ftruncate(fd, (off_t)file_bytes) != 0)) {
+            const int error = errno;
+            close(fd);
+            fail(error, "PersistentRingbuffer file");
+        }
+        const bool fresh = st.st_size == 0;
+        if( ! fresh && (size_t)st.st_size != file_bytes ) {
+            close(fd);
+            fail(EINVAL, "PersistentRingbuffer header");
+        }
+        void *map = mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        close(fd);
+        if(map == MAP_FAILED) fail(error, "mmap");
+        if(fresh || std::atomic_ref<uint32_t>(static_cast<Header *>(map)->magic).load(std::memory_order_acquire) == 0) {
+            Header *header = ::new (map) Header{0, Header::current_version, sizeof(T), N, data_offset, {0}, {0}};
+            // The magic goes in last, a file whose header is half written is initialised again on the next open().
+            std::atomic_ref<uint32_t>(header->magic).store(Header::magic_value, std::memory_order_release);
+        }
+        const Header *header = static_cast<const Header *>(map);
+        if( ! header->valid(file_bytes) || header->element_size != sizeof(T) || header->capacity != N
+            || header->data_offset != data_offset ) {
+            munmap(map, file_bytes);
+            fail(EINVAL, "PersistentRingbuffer header");
+        }
+        return PersistentRingbuffer(map);
+    }
+
+    PersistentRingbuffer(const PersistentRingbuffer &) = delete;
+    PersistentRingbuffer & operator=(const PersistentRingbuffer &) = delete;
+    PersistentRingbuffer(PersistentRingbuffer && other) noexcept
+        : m_header(std::exchange(other.m_header, nullptr)), m_data(std::exchange(other.m_data, nullptr)) {}
+    PersistentRingbuffer & operator=(PersistentRingbuffer && other) noexcept {
+        if(this != &other) {
+            if(m_header) munmap(m_header, file_bytes);
+            m_header = std::exchange(other.m_header, nullptr);
+            m_data = std::exchange(other.m_data, nullptr);
+        }
+        return *this;
+    }
+    ~PersistentRingbuffer() {
+        if(m_header) munmap(m_header, file_bytes);
+    }
+
+    /// @brief Appends item, overwriting the oldest element when full.
+    void push_back(const T & item) {
+        const uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+        if(tail - m_header->head.load(std::memory_order_relaxed) == N) {
+            m_header->head.store(tail - N + 1, std::memory_order_release);
+            // Keep the compiler from moving the overwrite above the head store.
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        }
+        m_data[tail % N] = item;
+        m_header->tail.store(tail + 1, std::memory_order_release);
+    }
+    void pop_front() {
+        m_header->head.store(m_header->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    void clear() {
+        m_header->head.store(m_header->tail.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    /// @brief Element i counted from the oldest one.
+    const T & operator[](size_t i) const {
+        return m_data[(m_header->head.load(std::memory_order_acquire) + i) % N];
+    }
+    const T & front() const { return (*this)[0]; }
+    const T & back() const { return (*this)[size() - 1]; }
+    /// @brief Calls f for every element, oldest first.
+    template<class F>
+    void for_each(F && f) const {
+        const uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+        for(uint64_t i = m_header->head.load(std::memory_order_acquire); i != tail; ++i) f(m_data[i % N]);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t size() const {
+        const uint64_t head = m_header->head.load(std::memory_order_acquire);
+        return static_cast<size_t>(m_header->tail.load(std::memory_order_acquire) - head);
+    }
+    static constexpr size_t capacity() { return N; }
+    /// @brief Elements pushed over the lifetime of the file, including overwritten ones.
+    uint64_t total_pushed() const { return m_header->tail.load(std::memory_order_acquire); }
+
+    /// @brief Writes the mapping back to the file, for surviving more than the process.
+    void sync() {
+        if(msync(m_header, file_bytes, MS_SYNC) != 0) fail(errno, "msync");
+    }
+};
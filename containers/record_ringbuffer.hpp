@@ -0,0 +1,182 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+#include "cache_line.hpp"
+
+/// Ring of variable-length byte records in N bytes of inline storage.
+///
+/// Each record is an 8 byte length header followed by the payload, padded to
+/// a multiple of 8 bytes, so payloads are 8 byte aligned. A record never wraps:
+/// when it does not fit before the end of the storage, the rest of the storage
+/// is filled with a padding record and it starts at offset 0 instead.
+///
+/// The producer serializes directly into the ring with reserve()/commit(), the
+/// consumer reads in place with peek()/release(). Unlike Ringbuffer a full ring
+/// rejects new records instead of overwriting unread ones.
+///
+/// With Spsc the ring is lock-free for exactly one producer thread and one
+/// consumer thread, like SpscRingbuffer; otherwise it is for a single thread.
+template<size_t N, bool Spsc = false>
+class RecordRingbuffer {
+    static_assert(N >= 16 && (N & (N - 1)) == 0, "N must be a power of two of at least 16 bytes");
+
+public:
+    static constexpr size_t record_alignment = sizeof(uint64_t);
+
+private:
+    using Position = std::conditional_t<Spsc, std::atomic<size_t>, size_t>;
+    static constexpr size_t side_alignment = Spsc ? cache_line_size : alignof(size_t);
+    static constexpr uint64_t padding = UINT64_MAX;
+
+    // Free running byte positions, the offset into m_data is position % N.
+    // Written by the consumer, read by the producer.
+    alignas(side_alignment) Position m_head{0};
+    size_t m_cached_tail{0};
+
+    // Written by the producer, read by the consumer.
+    alignas(side_alignment) Position m_tail{0};
+    size_t m_cached_head{0};
+    size_t m_reserved{0};   // start of the reserved record
+    size_t m_reserved_length{0};
+    bool m_reserving{false};
+
+    alignas(record_alignment) std::byte m_data[N];
+
+    static size_t load(const Position & position, std::memory_order order) {
+        if constexpr (Spsc) return position.load(order);
+        else { (void)order; return position; }
+    }
+    static void store(Position & position, size_t value, std::memory_order order) {
+        if constexpr (Spsc) position.store(value, order);
+        else { (void)order; position = value; }
+    }
+
+    static constexpr size_t offset(size_t position) { return position & (N - 1); }
+    static constexpr size_t record_size(size_t length) {
+        return sizeof(uint64_t) + (length + record_alignment - 1) / record_alignment * record_alignment;
+    }
+
+    uint64_t read_header(size_t position) const {
+        uint64_t header;
+        memcpy(&header, &m_data[offset(position)], sizeof(header));
+        return header;
+    }
+    void write_header(size_t position, uint64_t header) {
+        memcpy(&m_data[offset(position)], &header, sizeof(header));
+    }
+
+public:
+    RecordRingbuffer() = default;
+    RecordRingbuffer(const RecordRingbuffer &) = delete;
+    RecordRingbuffer & operator=(const RecordRingbuffer &) = delete;
+
+    /// @brief Largest payload reserve() accepts. Records up to this size always fit into an empty ring.
+    static constexpr size_t max_record_size() { return N / 2 - sizeof(uint64_t); }
+    static constexpr size_t capacity() { return N; }
+
+    /// @brief Producer side. Space for a record of length bytes, 8 byte aligned.
+    /// Returns a span with nullptr data when the ring has no room for it. Only
+    /// one record may be reserved at a time, it becomes visible on commit().
+    std::span<std::byte> reserve(size_t length) {
+        assert( ! m_reserving );
+        assert(length <= max_record_size());
+        const size_t tail = load(m_tail, std::memory_order_relaxed);
+        const size_t contiguous = N - offset(tail);
+        const size_t size = record_size(length);
+        const size_t needed = size > contiguous ? contiguous + size : size;
+        if(tail + needed - m_cached_head > N) {
+            m_cached_head = load(m_head, std::memory_order_acquire);
+            if(tail + needed - m_cached_head > N) return {};
+        }
+        size_t start = tail;
+        if(size > contiguous) {
+            write_header(tail, padding);
+            start += contiguous;
+        }
+        m_reserving = true;
+        m_reserved = start;
+        m_reserved_length = length;
+        return {&m_data[offset(start) + sizeof(uint64_t)], length};
+    }
+
+    /// @brief Producer side. Publishes the reserved record, shortened to length bytes.
+    void commit(size_t length) {
+        assert(m_reserving && length <= m_reserved_length);
+        write_header(m_reserved, length);
+        m_reserving = false;
+        store(m_tail, m_reserved + record_size(length), std::memory_order_release);
+    }
+    /// @brief Producer side. Publishes the reserved record with the length given to reserve().
+    void commit() { commit(m_reserved_length); }
+
+    /// @brief Producer side. Copies record into the ring, returns false when there is no room.
+    bool push(std::span<const std::byte> record) {
+        std::span<std::byte> dst = reserve(record.size());
+        if( ! dst.data() ) return false;
+        if( ! record.empty() ) memcpy(dst.data(), record.data(), record.size());
+        commit();
+        return true;
+    }
+
+    /// @brief Consumer side. The oldest record, or a span with nullptr data when the ring is empty.
+    /// The record stays valid until release().
+    std::span<const std::byte> peek() {
+        size_t head = load(m_head, std::memory_order_relaxed);
+        if(head == m_cached_tail) {
+            m_cached_tail = load(m_tail, std::memory_order_acquire);
+            if(head == m_cached_tail) return {};
+        }
+        uint64_t header = read_header(head);
+        if(header == padding) {
+            // Hand the padding back to the producer right away, the next record starts at offset 0.
+            head += N - offset(head);
+            store(m_head, head, std::memory_order_release);
+            header = read_header(head);
+        }
+        return {&m_data[offset(head) + sizeof(uint64_t)], static_cast<size_t>(header)};
+    }
+
+    /// @brief Consumer side. Frees the record returned by peek(), which must not have been empty.
+    void release() {
+        const size_t head = load(m_head, std::memory_order_relaxed);
+        assert(read_header(head) != padding);
+        store(m_head, head + record_size(read_header(head)), std::memory_order_release);
+    }
+
+    // Observers below give a snapshot which may be outdated by the time it is used
+    // if called from a thread other than the producer or the consumer.
+    bool empty() const {
+        return load(m_head, std::memory_order_acquire) == load(m_tail, std::memory_order_acquire);
+    }
+    /// @brief Bytes taken by unread records including headers and padding.
+    size_t used() const {
+        const size_t head = load(m_head, std::memory_order_acquire);
+        return load(m_tail, std::memory_order_acquire) - head;
+    }
+};
@@ -19,103 +19,294 @@ Containers. If not, see <https://www.gnu.org/licenses/>.
 #pragma once
 
 #ifdef USE_ITERATORS
+    #include <compare>
     #include <iterator>
     #include <initializer_list>
 #endif
 
+#include <algorithm>
 #include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 
-template<class T, size_t N>
+#include "container_stats.hpp"
+
+/// Slots outside of [head, tail) hold no object, elements are constructed
+/// when pushed and destroyed when popped or overwritten.
+/// Stats selects instrumentation, e.g. CountingStats, see stats().
+template<class T, size_t N, class Stats = NoStats>
 class Ringbuffer {
-    T m_data[N];
+    union { T m_data[N]; };
 public:
     class Index {
         size_t m_index{0};
+        // Power of two capacities wrap with a mask instead of a division.
+        static constexpr size_t wrap(size_t value) {
+            if constexpr ((N & (N - 1)) == 0) return value & (N - 1);
+            else return value % N;
+        }
     public:
         constexpr Index(size_t _index) : m_index(_index) {}
         explicit constexpr operator size_t() const { return m_index; }
         constexpr Index operator+(const Index & other) const {
-            return (this->m_index + other.m_index) % N;
+            return wrap(this->m_index + other.m_index);
         }
         constexpr Index operator-(const Index & other) const {
-            return ( N + this->m_index - other.m_index) % N;
+            return wrap(N + this->m_index - other.m_index);
         }
         constexpr const Index & operator+=(const Index & other) {
-            m_index = (m_index + other.m_index) % N;
+            m_index = wrap(m_index + other.m_index);
             return * this;
         }
         constexpr const Index & operator-=(const Index & other) {
-            m_index = (N + m_index - other.m_index) % N;
+            m_index = wrap(N + m_index - other.m_index);
             return * this;
         }
         constexpr Index operator++(int) { // post
             auto tmp = Index(*this);
-            m_index = (m_index + 1) % N;
+            m_index = wrap(m_index + 1);
             return tmp;
         }
         constexpr Index operator--(int) { // post
             auto tmp = Index(*this);
-            m_index = (N + m_index - 1) % N;
+            m_index = wrap(N + m_index - 1);
             return tmp;
         }
         constexpr Index operator++() { // pre
-            m_index = (m_index + 1) % N;
+            m_index = wrap(m_index + 1);
             return * this;
         }
         constexpr Index operator--() { // pre
-            m_index = (N + m_index - 1) % N;
+            m_index = wrap(N + m_index - 1);
             return * this;
         }
         constexpr auto operator<=>(const Index & other) const = default;
     };
 #ifdef USE_ITERATORS
-    class iterator : public std::iterator<
-                                std::random_access_iterator_tag,
-                                T,
-                                size_t,
-                                T*,
-                                T> {
-        Ringbuffer *m_buf{nullptr};
-        Index m_idx;
+    /// Random access iterator over the contained elements, front to back.
+    /// Positions are kept relative to the front, so iterators compare and
+    /// subtract like indices and stay valid until the front moves.
+    template<bool Const>
+    class basic_iterator {
+        using Buffer = std::conditional_t<Const, const Ringbuffer, Ringbuffer>;
+        Buffer *m_buf{nullptr};
+        std::ptrdiff_t m_pos{0};
         friend class Ringbuffer;
-        constexpr iterator(Ringbuffer * _buf, Index _idx) : m_buf(_buf), m_idx(_idx) {}
+        template<bool> friend class basic_iterator;
+        constexpr basic_iterator(Buffer * _buf, std::ptrdiff_t _pos) : m_buf(_buf), m_pos(_pos) {}
     public:
-        explicit constexpr iterator() = delete;
-        constexpr iterator& operator++() { m_idx++; return *this; }
-        constexpr iterator operator++(int) { auto tmp = *this; m_idx++; return tmp; }
-        constexpr bool operator==(iterator other) const { return m_idx == other.m_idx; }
-        constexpr bool operator!=(iterator other) const { return !(*this == other); }
-        constexpr T& operator*() const { return m_buf->m_data[(size_t)m_idx]; }
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        constexpr basic_iterator() = default;
+        template<bool OtherConst> requires (Const && !OtherConst)
+        constexpr basic_iterator(const basic_iterator<OtherConst> & other)
+            : m_buf(other.m_buf), m_pos(other.m_pos) {}
+
+        constexpr reference operator*() const { return m_buf->at_offset(m_pos); }
+        constexpr pointer operator->() const { return &m_buf->at_offset(m_pos); }
+        constexpr reference operator[](difference_type n) const { return m_buf->at_offset(m_pos + n); }
+
+        constexpr basic_iterator& operator++() { m_pos++; return *this; }
+        constexpr basic_iterator operator++(int) { auto tmp = *this; m_pos++; return tmp; }
+        constexpr basic_iterator& operator--() { m_pos--; return *this; }
+        constexpr basic_iterator operator--(int) { auto tmp = *this; m_pos--; return tmp; }
+        constexpr basic_iterator& operator+=(difference_type n) { m_pos += n; return *this; }
+        constexpr basic_iterator& operator-=(difference_type n) { m_pos -= n; return *this; }
+        constexpr basic_iterator operator+(difference_type n) const { return basic_iterator(m_buf, m_pos + n); }
+        constexpr basic_iterator operator-(difference_type n) const { return basic_iterator(m_buf, m_pos - n); }
+        friend constexpr basic_iterator operator+(difference_type n, const basic_iterator & it) { return it + n; }
+        constexpr difference_type operator-(const basic_iterator & other) const { return m_pos - other.m_pos; }
+
+        constexpr bool operator==(const basic_iterator & other) const { return m_pos == other.m_pos; }
+        constexpr auto operator<=>(const basic_iterator & other) const { return m_pos <=> other.m_pos; }
     };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 #endif
+    /// Up to two contiguous runs of slots, second is empty unless the run wraps.
+    template<class U>
+    struct BasicSegments {
+        std::span<U> first;
+        std::span<U> second;
+        constexpr size_t size() const { return first.size() + second.size(); }
+    };
+    using Segments = BasicSegments<T>;
+    using ConstSegments = BasicSegments<const T>;
 protected:
 
     Index m_head, m_tail;
+    [[no_unique_address]] Stats m_stats;
+
+    template<class Self>
+    static constexpr auto segments(Self & self, size_t from, size_t to) {
+        using U = std::remove_reference_t<decltype(self.m_data[0])>;
+        if(from <= to) return BasicSegments<U>{ std::span<U>(self.m_data + from, to - from), {} };
+        return BasicSegments<U>{ std::span<U>(self.m_data + from, N - from), std::span<U>(self.m_data, to) };
+    }
+    constexpr T & at_offset(std::ptrdiff_t offset) {
+        return m_data[(size_t)(m_head + Index((size_t)offset))];
+    }
+    constexpr const T & at_offset(std::ptrdiff_t offset) const {
+        return m_data[(size_t)(m_head + Index((size_t)offset))];
+    }
+    constexpr Segments free_segments() {
+        return segments(*this, (size_t)m_tail, (size_t)(m_head - 1));
+    }
+    /// @brief Drop count elements from the front without reporting them to Stats.
+    constexpr void discard_front(size_t count) {
+        if constexpr (std::is_trivially_destructible_v<T>) m_head += Index(count);
+        else while(count--) std::destroy_at(&m_data[(size_t)m_head++]);
+    }
+    constexpr void move_from(Ringbuffer & other) {
+        while( ! other.empty() ) {
+            emplace_back(std::move(other.front()));
+            other.pop_front();
+        }
+    }
 
 public:
     constexpr Ringbuffer() : m_head(0), m_tail(0) {}
     Ringbuffer(const Ringbuffer &) = delete;
     Ringbuffer & operator=(const Ringbuffer &) = delete;
+    constexpr Ringbuffer(Ringbuffer && other) : m_head(0), m_tail(0) {
+        move_from(other);
+    }
+    constexpr Ringbuffer & operator=(Ringbuffer && other) {
+        if(this != &other) {
+            clear();
+            move_from(other);
+        }
+        return *this;
+    }
+    constexpr ~Ringbuffer() {
+        clear();
+    }
 
-    constexpr void push_front(const T & item) {
-        m_data[(size_t)--m_head] = item;
-        if(m_head == m_tail) m_tail--;
+    template<class... Args>
+    constexpr T & emplace_front(Args &&... args) {
+        T * item = std::construct_at(&m_data[(size_t)(m_head - 1)], std::forward<Args>(args)...);
+        m_head--;
+        if(m_head == m_tail) {
+            std::destroy_at(&m_data[(size_t)--m_tail]);
+            m_stats.overwritten(1);
+        }
+        m_stats.pushed(1, size());
+        return *item;
     }
-    constexpr void push_back(const T & item) {
-        m_data[(size_t)m_tail++] = item;
-        if(m_head == m_tail) m_head++;
+    template<class... Args>
+    constexpr T & emplace_back(Args &&... args) {
+        T * item = std::construct_at(&m_data[(size_t)m_tail], std::forward<Args>(args)...);
+        m_tail++;
+        if(m_head == m_tail) {
+            std::destroy_at(&m_data[(size_t)m_head++]);
+            m_stats.overwritten(1);
+        }
+        m_stats.pushed(1, size());
+        return *item;
+    }
+    constexpr void push_front(const T & item) { emplace_front(item); }
+    constexpr void push_front(T && item) { emplace_front(std::move(item)); }
+    constexpr void push_back(const T & item) { emplace_back(item); }
+    constexpr void push_back(T && item) { emplace_back(std::move(item)); }
+    constexpr T & front() {
+        return m_data[(size_t)m_head];
     }
     constexpr const T & front() const {
         return m_data[(size_t)m_head];
     }
+    constexpr T & back() {
+        return m_data[(size_t)(m_tail-1)];
+    }
     constexpr const T & back() const {
         return m_data[(size_t)(m_tail-1)];
     }
     constexpr void pop_front() {
-        m_head++;
+        std::destroy_at(&m_data[(size_t)m_head++]);
+        m_stats.popped(1);
     }
     constexpr void pop_back() {
-        m_tail--;
+        std::destroy_at(&m_data[(size_t)--m_tail]);
+        m_stats.popped(1);
+    }
+    constexpr void clear() {
+        consume(size());
+    }
+    /// @brief Append all items with at most two copies, overwriting the oldest elements if needed.
+    constexpr void push_back(std::span<const T> items) {
+        const size_t pushed = items.size();
+        if(items.size() > capacity()) items = items.last(capacity());
+        const size_t free = capacity() - size();
+        const size_t evicted = items.size() > free ? items.size() - free : 0;
+        discard_front(evicted);
+        Segments dst = free_segments();
+        const size_t split = std::min(items.size(), dst.first.size());
+        std::uninitialized_copy(items.begin(), items.begin() + split, dst.first.begin());
+        std::uninitialized_copy(items.begin() + split, items.end(), dst.second.begin());
+        m_tail += Index(items.size());
+        m_stats.overwritten(evicted + (pushed - items.size()));
+        m_stats.pushed(pushed, size());
+    }
+    /// @brief Move up to out.size() elements from the front into out, returns their count.
+    constexpr size_t pop_front_into(std::span<T> out) {
+        const size_t count = std::min(out.size(), size());
+        Segments src = read_segments();
+        const size_t split = std::min(count, src.first.size());
+        std::move(src.first.begin(), src.first.begin() + split, out.begin());
+        std::move(src.second.begin(), src.second.begin() + (count - split), out.begin() + split);
+        consume(count);
+        return count;
+    }
+    /// @brief Contained elements, front to back.
+    constexpr Segments read_segments() {
+        return segments(*this, (size_t)m_head, (size_t)m_tail);
+    }
+    constexpr ConstSegments read_segments() const {
+        return segments(*this, (size_t)m_head, (size_t)m_tail);
+    }
+    /// @brief Call f with each non-empty contiguous std::span of elements, front to back.
+    /// Lets algorithms run over plain memory instead of wrapping every index.
+    template<class F>
+    constexpr void for_each_segment(F && f) {
+        Segments segs = read_segments();
+        if( ! segs.first.empty() ) f(segs.first);
+        if( ! segs.second.empty() ) f(segs.second);
+    }
+    template<class F>
+    constexpr void for_each_segment(F && f) const {
+        ConstSegments segs = read_segments();
+        if( ! segs.first.empty() ) f(segs.first);
+        if( ! segs.second.empty() ) f(segs.second);
+    }
+    /// @brief Free slots following back(), to be filled in place and published by commit().
+    /// Free slots hold no objects, so this is only offered for trivially copyable T.
+    constexpr Segments write_segments() requires std::is_trivially_copyable_v<T> {
+        return free_segments();
+    }
+    /// @brief Append count elements already written into write_segments().
+    constexpr void commit(size_t count) requires std::is_trivially_copyable_v<T> {
+        m_tail += Index(count);
+        m_stats.pushed(count, size());
+    }
+    /// @brief Drop count elements from the front, e.g. after reading them from read_segments().
+    constexpr void consume(size_t count) {
+        discard_front(count);
+        m_stats.popped(count);
+    }
+    /// @brief Counters collected by Stats (all zero with NoStats) and the current fill level.
+    constexpr ContainerStats stats() const {
+        ContainerStats snapshot = m_stats.snapshot();
+        snapshot.size = size();
+        snapshot.capacity = capacity();
+        return snapshot;
     }
     constexpr bool full() const { return m_head == m_tail + 1; }
     constexpr bool empty() const { return m_head == m_tail; }
@@ -126,11 +317,26 @@ public:
             m_data[(size_t)(m_head + (Index(idx)))]
             : m_data[(size_t)(m_tail + (Index(idx)))];
     }
+    constexpr const T & operator[](int idx) const {
+        return idx >= 0 ?
+            m_data[(size_t)(m_head + (Index(idx)))]
+            : m_data[(size_t)(m_tail + (Index(idx)))];
+    }
 #ifdef USE_ITERATORS
-    constexpr iterator begin() { return iterator(this, m_head); }
-    constexpr iterator end() { return iterator(this, m_tail); }
+    constexpr iterator begin() { return iterator(this, 0); }
+    constexpr iterator end() { return iterator(this, size()); }
+    constexpr const_iterator begin() const { return const_iterator(this, 0); }
+    constexpr const_iterator end() const { return const_iterator(this, size()); }
+    constexpr const_iterator cbegin() const { return begin(); }
+    constexpr const_iterator cend() const { return end(); }
+    constexpr reverse_iterator rbegin() { return reverse_iterator(end()); }
+    constexpr reverse_iterator rend() { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crbegin() const { return rbegin(); }
+    constexpr const_reverse_iterator crend() const { return rend(); }
     constexpr Ringbuffer(std::initializer_list<T> init) : m_head(0), m_tail(0) {
-        for(T value : init) {
+        for(const T & value : init) {
             push_back(value);
         }
     }
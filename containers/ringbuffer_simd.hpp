@@ -0,0 +1,326 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if ! defined(RINGBUFFER_NO_SIMD) && defined(__AVX2__)
+    #define RINGBUFFER_SIMD_AVX2
+    #include <immintrin.h>
+#elif ! defined(RINGBUFFER_NO_SIMD) && defined(__SSE2__)
+    #define RINGBUFFER_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+/// Search and reduction over the contents of a Ringbuffer, running on the one
+/// or two contiguous segments from read_segments() instead of wrapping every
+/// index. float and int16_t are vectorized with AVX2 or SSE2, whichever the
+/// compiler targets (e.g. -mavx2); other types, and all types when
+/// RINGBUFFER_NO_SIMD is defined, use the scalar loops. Every function is also
+/// available for a single std::span<const T>.
+namespace ringbuffer_simd {
+
+/// Integers are summed in long long, int16_t samples would overflow otherwise.
+template<class T>
+using sum_type = std::conditional_t<std::is_integral_v<T>, long long, T>;
+
+/// Vector operations for T, lanes elements at a time. Comparison masks carry
+/// mask_bits bits per element.
+template<class T>
+struct SimdOps;
+
+#if defined(RINGBUFFER_SIMD_AVX2)
+template<>
+struct SimdOps<float> {
+    using V = __m256;
+    using Acc = __m256;
+    static constexpr size_t lanes = 8;
+    static constexpr unsigned mask_bits = 1;
+    static constexpr size_t flush_interval = SIZE_MAX;
+    static V load(const float * p) { return _mm256_loadu_ps(p); }
+    static V splat(float value) { return _mm256_set1_ps(value); }
+    static unsigned eq_mask(V a, V b) { return (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    static unsigned gt_mask(V a, V b) { return (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static Acc acc_zero() { return _mm256_setzero_ps(); }
+    static Acc acc_add(Acc acc, V v) { return _mm256_add_ps(acc, v); }
+    static void store(float * p, V v) { _mm256_storeu_ps(p, v); }
+    static float acc_total(Acc acc) {
+        float lane[lanes];
+        _mm256_storeu_ps(lane, acc);
+        float total{0};
+        for(float value : lane) total += value;
+        return total;
+    }
+};
+
+template<>
+struct SimdOps<int16_t> {
+    using V = __m256i;
+    using Acc = __m256i; // 8 x int32
+    static constexpr size_t lanes = 16;
+    static constexpr unsigned mask_bits = 2;
+    // Each step adds at most 2 * 32768 to an int32 lane.
+    static constexpr size_t flush_interval = 16384;
+    static V load(const int16_t * p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+    static V splat(int16_t value) { return _mm256_set1_epi16(value); }
+    static unsigned eq_mask(V a, V b) { return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)); }
+    static unsigned gt_mask(V a, V b) { return (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi16(a, b)); }
+    static V min(V a, V b) { return _mm256_min_epi16(a, b); }
+    static V max(V a, V b) { return _mm256_max_epi16(a, b); }
+    static Acc acc_zero() { return _mm256_setzero_si256(); }
+    static Acc acc_add(Acc acc, V v) { return _mm256_add_epi32(acc, _mm256_madd_epi16(v, _mm256_set1_epi16(1))); }
+    static void store(int16_t * p, V v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+    static long long acc_total(Acc acc) {
+        int32_t lane[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(lane), acc);
+        long long total{0};
+        for(int32_t value : lane) total += value;
+        return total;
+    }
+};
+#elif defined(RINGBUFFER_SIMD_SSE2)
+template<>
+struct SimdOps<float> {
+    using V = __m128;
+    using Acc = __m128;
+    static constexpr size_t lanes = 4;
+    static constexpr unsigned mask_bits = 1;
+    static constexpr size_t flush_interval = SIZE_MAX;
+    static V load(const float * p) { return _mm_loadu_ps(p); }
+    static V splat(float value) { return _mm_set1_ps(value); }
+    static unsigned eq_mask(V a, V b) { return (unsigned)_mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+    static unsigned gt_mask(V a, V b) { return (unsigned)_mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+    static V min(V a, V b) { return _mm_min_ps(a, b); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static Acc acc_zero() { return _mm_setzero_ps(); }
+    static Acc acc_add(Acc acc, V v) { return _mm_add_ps(acc, v); }
+    static void store(float * p, V v) { _mm_storeu_ps(p, v); }
+    static float acc_total(Acc acc) {
+        float lane[lanes];
+        _mm_storeu_ps(lane, acc);
+        float total{0};
+        for(float value : lane) total += value;
+        return total;
+    }
+};
+
+template<>
+struct SimdOps<int16_t> {
+    using V = __m128i;
+    using Acc = __m128i; // 4 x int32
+    static constexpr size_t lanes = 8;
+    static constexpr unsigned mask_bits = 2;
+    // Each step adds at most 2 * 32768 to an int32 lane.
+    static constexpr size_t flush_interval = 16384;
+    static V load(const int16_t * p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static V splat(int16_t value) { return _mm_set1_epi16(value); }
+    static unsigned eq_mask(V a, V b) { return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi16(a, b)); }
+    static unsigned gt_mask(V a, V b) { return (unsigned)_mm_movemask_epi8(_mm_cmpgt_epi16(a, b)); }
+    static V min(V a, V b) { return _mm_min_epi16(a, b); }
+    static V max(V a, V b) { return _mm_max_epi16(a, b); }
+    static Acc acc_zero() { return _mm_setzero_si128(); }
+    static Acc acc_add(Acc acc, V v) { return _mm_add_epi32(acc, _mm_madd_epi16(v, _mm_set1_epi16(1))); }
+    static void store(int16_t * p, V v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+    static long long acc_total(Acc acc) {
+        int32_t lane[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(lane), acc);
+        long long total{0};
+        for(int32_t value : lane) total += value;
+        return total;
+    }
+};
+#endif
+
+template<class T>
+concept vectorized = requires { SimdOps<T>::lanes; };
+
+/// @brief Index of the first element equal to value, items.size() if there is none.
+template<class T>
+size_t find(std::span<const T> items, const std::type_identity_t<T> & value) {
+    size_t i = 0;
+    if constexpr (vectorized<T>) {
+        using Ops = SimdOps<T>;
+        const auto needle = Ops::splat(value);
+        for(; i + Ops::lanes <= items.size(); i += Ops::lanes) {
+            const unsigned bits = Ops::eq_mask(Ops::load(items.data() + i), needle);
+            if(bits) return i + std::countr_zero(bits) / Ops::mask_bits;
+        }
+    }
+    for(; i < items.size(); ++i) if(items[i] == value) return i;
+    return items.size();
+}
+
+/// @brief Index of the first element greater than threshold, items.size() if there is none.
+template<class T>
+size_t find_above(std::span<const T> items, const std::type_identity_t<T> & threshold) {
+    size_t i = 0;
+    if constexpr (vectorized<T>) {
+        using Ops = SimdOps<T>;
+        const auto limit = Ops::splat(threshold);
+        for(; i + Ops::lanes <= items.size(); i += Ops::lanes) {
+            const unsigned bits = Ops::gt_mask(Ops::load(items.data() + i), limit);
+            if(bits) return i + std::countr_zero(bits) / Ops::mask_bits;
+        }
+    }
+    for(; i < items.size(); ++i) if(items[i] > threshold) return i;
+    return items.size();
+}
+
+/// @brief Number of elements equal to value.
+template<class T>
+size_t count(std::span<const T> items, const std::type_identity_t<T> & value) {
+    size_t i = 0;
+    size_t result = 0;
+    if constexpr (vectorized<T>) {
+        using Ops = SimdOps<T>;
+        const auto needle = Ops::splat(value);
+        for(; i + Ops::lanes <= items.size(); i += Ops::lanes) {
+            result += std::popcount(Ops::eq_mask(Ops::load(items.data() + i), needle)) / Ops::mask_bits;
+        }
+    }
+    for(; i < items.size(); ++i) result += items[i] == value;
+    return result;
+}
+
+namespace detail {
+
+template<class T, bool Max>
+T extreme(std::span<const T> items) {
+    auto better = [](const T & a, const T & b) { return Max ? b < a : a < b; };
+    size_t i = 0;
+    T result = items[0];
+    if constexpr (vectorized<T>) {
+        using Ops = SimdOps<T>;
+        if(items.size() >= Ops::lanes) {
+            auto acc = Ops::load(items.data());
+            for(i = Ops::lanes; i + Ops::lanes <= items.size(); i += Ops::lanes) {
+                const auto v = Ops::load(items.data() + i);
+                acc = Max ? Ops::max(acc, v) : Ops::min(acc, v);
+            }
+            T lane[Ops::lanes];
+            Ops::store(lane, acc);
+            for(const T & value : lane) if(better(value, result)) result = value;
+        }
+    }
+    for(; i < items.size(); ++i) if(better(items[i], result)) result = items[i];
+    return result;
+}
+
+}
+
+/// @brief Smallest element, items must not be empty.
+template<class T>
+T min(std::span<const T> items) { return detail::extreme<T, false>(items); }
+
+/// @brief Largest element, items must not be empty.
+template<class T>
+T max(std::span<const T> items) { return detail::extreme<T, true>(items); }
+
+/// @brief Sum of all elements. Vectorized float sums add in a different order
+/// than the scalar loop and may differ in the last bits.
+template<class T>
+sum_type<T> sum(std::span<const T> items) {
+    size_t i = 0;
+    sum_type<T> result{0};
+    if constexpr (vectorized<T>) {
+        using Ops = SimdOps<T>;
+        while(i + Ops::lanes <= items.size()) {
+            auto acc = Ops::acc_zero();
+            for(size_t steps = 0; steps < Ops::flush_interval && i + Ops::lanes <= items.size(); ++steps) {
+                acc = Ops::acc_add(acc, Ops::load(items.data() + i));
+                i += Ops::lanes;
+            }
+            result += Ops::acc_total(acc);
+        }
+    }
+    for(; i < items.size(); ++i) result += items[i];
+    return result;
+}
+
+template<class Ring>
+concept segmented = requires(const Ring & ring) { ring.read_segments().second; };
+
+/// @brief Index of the first element (from the front) equal to value, ring.size() if there is none.
+template<segmented Ring, class T>
+size_t find(const Ring & ring, const T & value) {
+    const auto segs = ring.read_segments();
+    const size_t idx = find(segs.first, value);
+    if(idx < segs.first.size()) return idx;
+    return segs.first.size() + find(segs.second, value);
+}
+
+/// @brief Index of the first element (from the front) greater than threshold, ring.size() if there is none.
+template<segmented Ring, class T>
+size_t find_above(const Ring & ring, const T & threshold) {
+    const auto segs = ring.read_segments();
+    const size_t idx = find_above(segs.first, threshold);
+    if(idx < segs.first.size()) return idx;
+    return segs.first.size() + find_above(segs.second, threshold);
+}
+
+template<segmented Ring, class T>
+size_t count(const Ring & ring, const T & value) {
+    const auto segs = ring.read_segments();
+    return count(segs.first, value) + count(segs.second, value);
+}
+
+/// @brief Smallest element, ring must not be empty.
+template<segmented Ring>
+auto min(const Ring & ring) {
+    const auto segs = ring.read_segments();
+    auto result = min(segs.first);
+    return segs.second.empty() ? result : std::min(result, min(segs.second));
+}
+
+/// @brief Largest element, ring must not be empty.
+template<segmented Ring>
+auto max(const Ring & ring) {
+    const auto segs = ring.read_segments();
+    auto result = max(segs.first);
+    return segs.second.empty() ? result : std::max(result, max(segs.second));
+}
+
+template<segmented Ring>
+auto sum(const Ring & ring) {
+    const auto segs = ring.read_segments();
+    return sum(segs.first) + sum(segs.second);
+}
+
+/// @brief Mean of the newest min(window, size()) elements, 0 when empty.
+template<segmented Ring>
+double moving_average(const Ring & ring, size_t window) {
+    const auto segs = ring.read_segments();
+    window = std::min(window, segs.size());
+    if(window == 0) return 0;
+    // The newest elements are at the end of second, spilling into first.
+    const size_t from_second = std::min(window, segs.second.size());
+    const size_t from_first = window - from_second;
+    const double total = static_cast<double>(sum(segs.second.last(from_second)))
+        + static_cast<double>(sum(segs.first.last(from_first)));
+    return total / static_cast<double>(window);
+}
+
+}
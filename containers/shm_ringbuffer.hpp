@@ -0,0 +1,303 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "cache_line.hpp"
+
+/// Single producer, single consumer ring buffer living in a POSIX shared memory
+/// segment, for passing elements between processes without copying through a pipe.
+///
+/// One process calls create(), the other attach() with the same name. The segment
+/// starts with a Header which is validated on attach and holds only offsets and
+/// free-running 32 bit indices, so every process may map it at a different address.
+/// try_push/try_pop never block; push/pop sleep on a shared futex when the buffer
+/// is full/empty, and the other side only issues the wake syscall if somebody sleeps.
+/// The side going to sleep pays for the handshake with a membarrier() call, which
+/// forces a barrier on every thread of the attached processes, so publishing an
+/// index needs no fence on either side (Linux 4.16 or later).
+/// The producer and the consumer may each be used by one thread at a time.
+template<class T>
+class ShmRingbuffer {
+    static_assert(std::is_trivially_copyable_v<T>, "elements are shared between processes, T must be trivially copyable");
+    static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+public:
+    static constexpr uint32_t magic = 0x48534252; // "RBSH"
+    static constexpr uint32_t version = 1;
+    /// Largest capacity, indices are free-running 32 bit values.
+    static constexpr uint64_t max_capacity = uint64_t(1) << 31;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t capacity;
+        uint64_t element_size;
+        uint64_t data_offset;
+        // Written by the consumer.
+        alignas(cache_line_size) std::atomic<uint32_t> head;
+        std::atomic<uint32_t> producer_waiting;
+        // Written by the producer.
+        alignas(cache_line_size) std::atomic<uint32_t> tail;
+        std::atomic<uint32_t> consumer_waiting;
+    };
+
+private:
+    static constexpr size_t data_align = std::max(alignof(T), cache_line_size);
+    static constexpr uint64_t data_offset = (sizeof(Header) + data_align - 1) / data_align * data_align;
+
+    Header *m_header{nullptr};
+    T *m_data{nullptr};
+    size_t m_map_bytes{0};
+    uint32_t m_mask{0};
+    // Process local copies of the other side's index.
+    uint32_t m_cached_head{0};
+    uint32_t m_cached_tail{0};
+
+    [[noreturn]] static void fail(int error, const char * what) {
+        throw std::system_error(error, std::system_category(), what);
+    }
+
+    // Not FUTEX_PRIVATE_FLAG, the word is shared between processes.
+    static void futex_wait(std::atomic<uint32_t> & word, uint32_t expected) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+    }
+    static void futex_wake(std::atomic<uint32_t> & word) {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+    }
+
+    // Every process mapping the segment registers, so barrier() reaches its threads.
+    static void register_barrier() {
+        if(syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_GLOBAL_EXPEDITED, 0, 0) != 0) fail(errno, "membarrier");
+    }
+    static void barrier() {
+        syscall(SYS_membarrier, MEMBARRIER_CMD_GLOBAL_EXPEDITED, 0, 0);
+    }
+
+    /// @brief Sleeps until word no longer holds expected, announcing itself in waiting.
+    /// The barrier orders the announcement against the other side, whose publish
+    /// and check in wake() are thereby either both before or both after it.
+    static void sleep_while(std::atomic<uint32_t> & word, uint32_t expected, std::atomic<uint32_t> & waiting) {
+        waiting.store(1, std::memory_order_relaxed);
+        barrier();
+        if(word.load(std::memory_order_relaxed) == expected) futex_wait(word, expected);
+        waiting.store(0, std::memory_order_relaxed);
+    }
+    /// @brief Counterpart of sleep_while, called after word was changed.
+    /// Only the compiler has to keep the check behind the change, see sleep_while.
+    static void wake(std::atomic<uint32_t> & word, std::atomic<uint32_t> & waiting) {
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        if(waiting.load(std::memory_order_relaxed)) futex_wake(word);
+    }
+
+    bool push_item(const T & item) {
+        const uint32_t tail = m_header->tail.load(std::memory_order_relaxed);
+        if(tail - m_cached_head > m_mask) {
+            m_cached_head = m_header->head.load(std::memory_order_acquire);
+            if(tail - m_cached_head > m_mask) return false;
+        }
+        m_data[tail & m_mask] = item;
+        m_header->tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    void release_head() {
+        const uint32_t head = m_header->head.load(std::memory_order_relaxed);
+        m_header->head.store(head + 1, std::memory_order_release);
+    }
+
+    ShmRingbuffer(void * map, size_t map_bytes)
+        : m_header(static_cast<Header *>(map)),
+          m_data(reinterpret_cast<T *>(static_cast<char *>(map) + m_header->data_offset)),
+          m_map_bytes(map_bytes),
+          m_mask(static_cast<uint32_t>(m_header->capacity - 1)),
+          m_cached_head(m_header->head.load(std::memory_order_acquire)),
+          m_cached_tail(m_header->tail.load(std::memory_order_acquire)) {}
+
+    static void * map_fd(int fd, size_t bytes) {
+        void *map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int error = errno;
+        close(fd);
+        if(map == MAP_FAILED) fail(error, "mmap");
+        return map;
+    }
+
+public:
+    /// @brief Creates the segment name (e.g. "/my_channel") holding at least
+    /// min_capacity elements, rounded up to a power of two.
+    /// @throws std::system_error, also when the segment already exists.
+    static ShmRingbuffer create(const char * name, size_t min_capacity) {
+        register_barrier();
+        if(min_capacity == 0 || min_capacity > max_capacity
+            || std::bit_ceil(min_capacity) > (SIZE_MAX - data_offset) / sizeof(T)) {
+            fail(EINVAL, "ShmRingbuffer capacity");
+        }
+        const uint64_t capacity = std::bit_ceil(min_capacity);
+        const size_t bytes = data_offset + capacity * sizeof(T);
+        const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if(fd < 0) fail(errno, "shm_open");
+        if(ftruncate(fd, (off_t)bytes) != 0) {
+            const int error = errno;
+            close(fd);
+            shm_unlink(name);
+            fail(error, "ftruncate");
+        }
+        void *map = map_fd(fd, bytes);
+        Header *header = ::new (map) Header{0, version, capacity, sizeof(T), data_offset, {0}, {0}, {0}, {0}};
+        // Publish the magic last, attach() refuses a header which is still being filled in.
+        std::atomic_ref<uint32_t>(header->magic).store(magic, std::memory_order_release);
+        return ShmRingbuffer(map, bytes);
+    }
+
+    /// @brief Maps the segment name created by another process.
+    /// @throws std::system_error, with std::errc::invalid_argument when the header
+    /// does not match this element type or the layout version.
+    static ShmRingbuffer attach(const char * name) {
+        register_barrier();
+        const int fd = shm_open(name, O_RDWR, 0);
+        if(fd < 0) fail(errno, "shm_open");
+        struct stat st;
+        if(fstat(fd, &st) != 0) {
+            const int error = errno;
+            close(fd);
+            fail(error, "fstat");
+        }
+        const size_t bytes = (size_t)st.st_size;
+        if(bytes < sizeof(Header)) {
+            close(fd);
+            fail(EINVAL, "ShmRingbuffer header");
+        }
+        void *map = map_fd(fd, bytes);
+        Header *header = static_cast<Header *>(map);
+        const bool valid = std::atomic_ref<uint32_t>(header->magic).load(std::memory_order_acquire) == magic
+            && header->version == version
+            && header->element_size == sizeof(T)
+            && header->data_offset == data_offset
+            && std::has_single_bit(header->capacity)
+            && header->capacity <= max_capacity
+            && bytes >= data_offset
+            && (bytes - data_offset) / sizeof(T) >= header->capacity;
+        if( ! valid ) {
+            munmap(map, bytes);
+            fail(EINVAL, "ShmRingbuffer header");
+        }
+        return ShmRingbuffer(map, bytes);
+    }
+
+    /// @brief Removes the segment name, mappings stay valid until they are destroyed.
+    static void unlink(const char * name) { shm_unlink(name); }
+
+    ShmRingbuffer(const ShmRingbuffer &) = delete;
+    ShmRingbuffer & operator=(const ShmRingbuffer &) = delete;
+    ShmRingbuffer(ShmRingbuffer && other) noexcept
+        : m_header(std::exchange(other.m_header, nullptr)), m_data(std::exchange(other.m_data, nullptr)),
+          m_map_bytes(std::exchange(other.m_map_bytes, 0)), m_mask(other.m_mask),
+          m_cached_head(other.m_cached_head), m_cached_tail(other.m_cached_tail) {}
+    ShmRingbuffer & operator=(ShmRingbuffer && other) noexcept {
+        if(this != &other) {
+            if(m_header) munmap(m_header, m_map_bytes);
+            m_header = std::exchange(other.m_header, nullptr);
+            m_data = std::exchange(other.m_data, nullptr);
+            m_map_bytes = std::exchange(other.m_map_bytes, 0);
+            m_mask = other.m_mask;
+            m_cached_head = other.m_cached_head;
+            m_cached_tail = other.m_cached_tail;
+        }
+        return *this;
+    }
+    ~ShmRingbuffer() {
+        if(m_header) munmap(m_header, m_map_bytes);
+    }
+
+    /// @brief Producer side. Returns false and leaves the buffer untouched when full.
+    bool try_push(const T & item) {
+        if( ! push_item(item) ) return false;
+        wake(m_header->tail, m_header->consumer_waiting);
+        return true;
+    }
+    /// @brief Producer side. Sleeps while the buffer is full.
+    void push(const T & item) {
+        while( ! push_item(item) ) {
+            const uint32_t tail = m_header->tail.load(std::memory_order_relaxed);
+            sleep_while(m_header->head, tail - m_mask - 1, m_header->producer_waiting);
+        }
+        wake(m_header->tail, m_header->consumer_waiting);
+    }
+
+    /// @brief Consumer side. Oldest element, still in the shared segment, or nullptr when empty.
+    T * front() {
+        const uint32_t head = m_header->head.load(std::memory_order_relaxed);
+        if(head == m_cached_tail) {
+            m_cached_tail = m_header->tail.load(std::memory_order_acquire);
+            if(head == m_cached_tail) return nullptr;
+        }
+        return &m_data[head & m_mask];
+    }
+    /// @brief Consumer side. Releases the slot returned by front(), which must not be nullptr.
+    void pop_front() {
+        release_head();
+        wake(m_header->head, m_header->producer_waiting);
+    }
+    /// @brief Consumer side. Copies the oldest element into item, returns false when empty.
+    bool try_pop(T & item) {
+        T *head = front();
+        if( ! head ) return false;
+        item = *head;
+        pop_front();
+        return true;
+    }
+    /// @brief Consumer side. Sleeps while the buffer is empty.
+    void pop(T & item) {
+        T *head;
+        while( ! (head = front()) ) {
+            sleep_while(m_header->tail, m_header->head.load(std::memory_order_relaxed), m_header->consumer_waiting);
+        }
+        item = *head;
+        release_head();
+        wake(m_header->head, m_header->producer_waiting);
+    }
+
+    // Snapshots, may be outdated by the time they are used.
+    size_t size() const {
+        const uint32_t tail = m_header->tail.load(std::memory_order_acquire);
+        return tail - m_header->head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() == capacity(); }
+    size_t capacity() const { return (size_t)m_mask + 1; }
+};
@@ -0,0 +1,121 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "cache_line.hpp"
+#include "ringbuffer.hpp"
+
+/// Lock-free ring buffer for exactly one producer thread and one consumer thread.
+///
+/// The producer calls try_push, the consumer calls try_pop, front and pop_front.
+/// Unlike Ringbuffer::push_back, try_push never overwrites unread data and fails
+/// when the buffer is full instead. Each side keeps a cached copy of the other
+/// side's index, so the consumer's cache line is only read when the producer
+/// believes the buffer is full (and vice versa for empty).
+/// Like Ringbuffer, slots outside of [head, tail) hold no object.
+template<class T, size_t N>
+class SpscRingbuffer {
+public:
+    using Index = typename Ringbuffer<T, N>::Index;
+
+private:
+    // Written by the consumer, read by the producer.
+    alignas(cache_line_size) std::atomic<size_t> m_head{0};
+    size_t m_cached_tail{0};
+
+    // Written by the producer, read by the consumer.
+    alignas(cache_line_size) std::atomic<size_t> m_tail{0};
+    size_t m_cached_head{0};
+
+    union { alignas(cache_line_size) T m_data[N]; };
+
+    static constexpr size_t next(size_t idx) { return static_cast<size_t>(Index(idx) + 1); }
+
+    template<class U>
+    bool push(U && item) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t next_tail = next(tail);
+        if(next_tail == m_cached_head) {
+            m_cached_head = m_head.load(std::memory_order_acquire);
+            if(next_tail == m_cached_head) return false;
+        }
+        std::construct_at(&m_data[tail], std::forward<U>(item));
+        m_tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+public:
+    SpscRingbuffer() {}
+    SpscRingbuffer(const SpscRingbuffer &) = delete;
+    SpscRingbuffer & operator=(const SpscRingbuffer &) = delete;
+    ~SpscRingbuffer() {
+        while(front()) pop_front();
+    }
+
+    /// @brief Producer side. Returns false and leaves the buffer untouched when full.
+    bool try_push(const T & item) { return push(item); }
+    bool try_push(T && item) { return push(std::move(item)); }
+
+    /// @brief Consumer side. Moves the oldest element into item, returns false when empty.
+    bool try_pop(T & item) {
+        T * head = front();
+        if( ! head ) return false;
+        item = std::move(*head);
+        pop_front();
+        return true;
+    }
+
+    /// @brief Consumer side. Oldest element or nullptr when empty.
+    T * front() {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if(head == m_cached_tail) {
+            m_cached_tail = m_tail.load(std::memory_order_acquire);
+            if(head == m_cached_tail) return nullptr;
+        }
+        return &m_data[head];
+    }
+
+    /// @brief Consumer side. Destroys the element returned by front(), which must not be nullptr.
+    void pop_front() {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        std::destroy_at(&m_data[head]);
+        m_head.store(next(head), std::memory_order_release);
+    }
+
+    // Observers below give a snapshot which may be outdated by the time it is used
+    // if called from a thread other than the producer or the consumer.
+    bool empty() const {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+    bool full() const {
+        return next(m_tail.load(std::memory_order_acquire)) == m_head.load(std::memory_order_acquire);
+    }
+    size_t size() const {
+        const Index tail = m_tail.load(std::memory_order_acquire);
+        const Index head = m_head.load(std::memory_order_acquire);
+        return static_cast<size_t>(tail - head);
+    }
+    constexpr size_t capacity() const { return N - 1; }
+};
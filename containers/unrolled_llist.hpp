@@ -0,0 +1,246 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef USE_ITERATORS
+    #include <iterator>
+    #include <initializer_list>
+#endif
+
+
+/// Doubly linked list of chunks holding up to ChunkSize elements each.
+/// Small elements are stored next to each other, so a scan touches one node
+/// (and pays two pointers of overhead) per ChunkSize elements instead of per
+/// element. Pushing and popping at either end is O(1) and elements never move,
+/// references and iterators stay valid until their element is popped.
+template<class T, size_t ChunkSize = 16, class Allocator = std::allocator<T>>
+class UnrolledLList {
+    static_assert(ChunkSize > 0 && ChunkSize <= UINT32_MAX);
+
+    struct Chunk {
+        // Slots [begin, end) hold elements.
+        union { T items[ChunkSize]; };
+        uint32_t begin;
+        uint32_t end;
+        Chunk * prev{nullptr};
+        Chunk * next{nullptr};
+        Chunk(uint32_t at) : begin(at), end(at) {}
+        ~Chunk() {}
+        bool empty() const { return begin == end; }
+    };
+    using ChunkAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+    Chunk * head{nullptr};
+    Chunk * tail{nullptr};
+    size_t count{0};
+    [[no_unique_address]] ChunkAllocator alloc;
+
+    Chunk * create_chunk(size_t at) {
+        Chunk * chunk = ChunkTraits::allocate(alloc, 1);
+        return ::new (chunk) Chunk(at);
+    }
+
+    void destroy_chunk(Chunk * chunk) {
+        chunk->~Chunk();
+        ChunkTraits::deallocate(alloc, chunk, 1);
+    }
+public:
+
+#ifdef USE_ITERATORS
+    template<bool Const>
+    class basic_iterator {
+        using ChunkPtr = std::conditional_t<Const, const Chunk *, Chunk *>;
+        ChunkPtr chunk{nullptr};
+        size_t idx{0};
+        basic_iterator(ChunkPtr chunk, size_t idx) : chunk(chunk), idx(idx) {}
+        friend class UnrolledLList;
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+
+        basic_iterator() = default;
+        inline reference operator*() const { assert(chunk); return chunk->items[idx]; }
+        inline pointer operator->() const { assert(chunk); return &chunk->items[idx]; }
+        inline basic_iterator & operator++() { // pre
+            assert(chunk);
+            if(++idx == chunk->end) {
+                chunk = chunk->next;
+                idx = chunk ? chunk->begin : 0;
+            }
+            return *this;
+        }
+        inline basic_iterator & operator--() { // pre, end() can not be decremented
+            assert(chunk);
+            if(idx == chunk->begin) {
+                chunk = chunk->prev;
+                idx = chunk ? chunk->end : 0;
+            }
+            idx--;
+            return *this;
+        }
+        inline basic_iterator operator++(int) { auto tmp = basic_iterator(*this); ++*this; return tmp; } // post
+        inline basic_iterator operator--(int) { auto tmp = basic_iterator(*this); --*this; return tmp; } // post
+        inline bool operator==(const basic_iterator & other) const { return chunk == other.chunk && idx == other.idx; }
+        inline bool operator!=(const basic_iterator & other) const { return !(*this == other); }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    iterator begin() { return head ? iterator(head, head->begin) : end(); }
+    iterator end() { return iterator(nullptr, 0); }
+    const_iterator begin() const { return head ? const_iterator(head, head->begin) : end(); }
+    const_iterator end() const { return const_iterator(nullptr, 0); }
+
+    UnrolledLList(std::initializer_list<T> list) {
+        for(const auto & value : list) push_back(value);
+    }
+#endif // USE_ITERATORS
+
+    UnrolledLList(const UnrolledLList &) = delete;
+    UnrolledLList & operator=(const UnrolledLList &) = delete;
+    UnrolledLList() {}
+
+    /// Chunks are taken over when the allocators are interchangeable,
+    /// otherwise elements are moved one by one into chunks of this list.
+    UnrolledLList(UnrolledLList && other) {
+        take(other);
+    }
+    UnrolledLList & operator=(UnrolledLList && other) {
+        if(this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+
+    template<class... Args>
+    T & emplace_front(Args &&... args) {
+        if( ! head || head->begin == 0 ) {
+            Chunk * chunk = create_chunk(ChunkSize);
+            if( ! head ) { head = tail = chunk; }
+            else { head->prev = chunk; chunk->next = head; head = chunk; }
+        }
+        T * item = std::construct_at(&head->items[head->begin - 1], std::forward<Args>(args)...);
+        head->begin--;
+        count++;
+        return *item;
+    }
+
+    template<class... Args>
+    T & emplace_back(Args &&... args) {
+        if( ! tail || tail->end == ChunkSize ) {
+            Chunk * chunk = create_chunk(0);
+            if( ! tail ) { head = tail = chunk; }
+            else { tail->next = chunk; chunk->prev = tail; tail = chunk; }
+        }
+        T * item = std::construct_at(&tail->items[tail->end], std::forward<Args>(args)...);
+        tail->end++;
+        count++;
+        return *item;
+    }
+
+    void push_front(const T & item) { emplace_front(item); }
+    void push_front(T && item) { emplace_front(std::move(item)); }
+    void push_back(const T & item) { emplace_back(item); }
+    void push_back(T && item) { emplace_back(std::move(item)); }
+
+    void pop_front() {
+        assert(head);
+        std::destroy_at(&head->items[head->begin++]);
+        count--;
+        if(head->empty()) {
+            Chunk * tmp = head;
+            head = head->next;
+            if( !head ) tail = nullptr;
+            else head->prev = nullptr;
+            destroy_chunk(tmp);
+        }
+    }
+
+    void pop_back() {
+        assert(tail);
+        std::destroy_at(&tail->items[--tail->end]);
+        count--;
+        if(tail->empty()) {
+            Chunk * tmp = tail;
+            tail = tail->prev;
+            if( !tail ) head = nullptr;
+            else tail->next = nullptr;
+            destroy_chunk(tmp);
+        }
+    }
+
+    bool empty() const {
+        assert( (!head) == (!tail) );
+        return head == nullptr;
+    }
+    size_t size() const { return count; }
+
+    const ChunkAllocator & get_allocator() const { return alloc; }
+
+    T & front() { return head->items[head->begin]; }
+    const T & front() const { return head->items[head->begin]; }
+    T & back() { return tail->items[tail->end - 1]; }
+    const T & back() const { return tail->items[tail->end - 1]; }
+
+    void clear() {
+        while(head) {
+            Chunk * chunk = head;
+            head = head->next;
+            if constexpr ( ! std::is_trivially_destructible_v<T> ) {
+                std::destroy(chunk->items + chunk->begin, chunk->items + chunk->end);
+            }
+            destroy_chunk(chunk);
+        }
+        tail = nullptr;
+        count = 0;
+    }
+
+    ~UnrolledLList() {
+        clear();
+    }
+
+private:
+    void take(UnrolledLList & other) {
+        if constexpr (ChunkTraits::is_always_equal::value) {
+            head = other.head;
+            tail = other.tail;
+            count = other.count;
+            other.head = other.tail = nullptr;
+            other.count = 0;
+        } else {
+            while( ! other.empty() ) {
+                push_back(std::move(other.front()));
+                other.pop_front();
+            }
+        }
+    }
+};
@@ -0,0 +1,187 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "ringbuffer.hpp"
+
+/// The last Window pushed values together with their sum, sum of squares,
+/// minimum and maximum, all updated in O(1) (amortised for min/max) as values
+/// are pushed and the oldest one is overwritten, so every query is O(1).
+///
+/// Sums are kept as long long for integral T and double otherwise. Min and max
+/// come from monotonic deques of (sequence number, value) pairs: a new value
+/// drops every queued value it makes irrelevant, the front leaves when its
+/// element falls out of the window.
+template<class T, size_t Window>
+class WindowStats {
+    static_assert(Window > 0);
+public:
+    using Acc = std::conditional_t<std::is_integral_v<T>, long long, double>;
+
+private:
+    struct Entry {
+        uint64_t seq;
+        T value;
+    };
+
+    // Ringbuffer<T, N> holds N - 1 elements.
+    Ringbuffer<T, Window + 1> m_window;
+    Ringbuffer<Entry, Window + 1> m_min;
+    Ringbuffer<Entry, Window + 1> m_max;
+    uint64_t m_seq{0}; // sequence number of the next push
+    Acc m_sum{0};
+    Acc m_sum_sq{0};
+
+    template<class Better>
+    static void enqueue(Ringbuffer<Entry, Window + 1> & deque, uint64_t seq, const T & value, Better better) {
+        while( ! deque.empty() && ! better(deque.back().value, value) ) deque.pop_back();
+        deque.push_back(Entry{seq, value});
+    }
+
+public:
+    /// @brief Appends value, evicting the oldest one when the window is full.
+    void push(const T & value) {
+        if(m_window.full()) {
+            const T & oldest = m_window.front();
+            m_sum -= static_cast<Acc>(oldest);
+            m_sum_sq -= static_cast<Acc>(oldest) * static_cast<Acc>(oldest);
+            const uint64_t oldest_seq = m_seq - Window;
+            if(m_min.front().seq == oldest_seq) m_min.pop_front();
+            if(m_max.front().seq == oldest_seq) m_max.pop_front();
+            m_window.pop_front();
+        }
+        m_window.push_back(value);
+        m_sum += static_cast<Acc>(value);
+        m_sum_sq += static_cast<Acc>(value) * static_cast<Acc>(value);
+        enqueue(m_min, m_seq, value, [](const T & queued, const T & added) { return queued < added; });
+        enqueue(m_max, m_seq, value, [](const T & queued, const T & added) { return added < queued; });
+        m_seq++;
+    }
+
+    void clear() {
+        m_window.clear();
+        m_min.clear();
+        m_max.clear();
+        m_sum = m_sum_sq = 0;
+    }
+
+    size_t size() const { return m_window.size(); }
+    bool empty() const { return m_window.empty(); }
+    bool full() const { return m_window.full(); }
+    static constexpr size_t capacity() { return Window; }
+    const Ringbuffer<T, Window + 1> & values() const { return m_window; }
+
+    Acc sum() const { return m_sum; }
+    Acc sum_of_squares() const { return m_sum_sq; }
+    /// @brief The queries below require a non-empty window.
+    double mean() const { return static_cast<double>(m_sum) / static_cast<double>(size()); }
+    /// @brief Population variance.
+    double variance() const {
+        const double m = mean();
+        return std::max(0.0, static_cast<double>(m_sum_sq) / static_cast<double>(size()) - m * m);
+    }
+    const T & min() const { return m_min.front().value; }
+    const T & max() const { return m_max.front().value; }
+};
+
+/// Aggregate operations for WindowAggregate. An operation provides the
+/// aggregate value_type, lift() turning an element into an aggregate, an
+/// associative combine() and its identity(). combine() need not be commutative,
+/// its left operand always covers older elements.
+template<class T>
+struct MaxAggregate {
+    using value_type = T;
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    static T lift(const T & value) { return value; }
+    static T combine(const T & older, const T & newer) { return std::max(older, newer); }
+};
+
+template<class T>
+struct MinAggregate {
+    using value_type = T;
+    static T identity() { return std::numeric_limits<T>::max(); }
+    static T lift(const T & value) { return value; }
+    static T combine(const T & older, const T & newer) { return std::min(older, newer); }
+};
+
+/// Any associative aggregate over the last Window pushed elements, O(1)
+/// amortised per push and O(1) per query (two-stack queue).
+///
+/// New elements go onto the back stack, which only keeps a running aggregate.
+/// Evictions pop the front stack, whose entries hold the aggregate of their
+/// element and every newer element on that stack. When it runs empty the back
+/// stack is turned over into it, oldest element ending on top.
+template<class T, size_t Window, class Op>
+class WindowAggregate {
+    static_assert(Window > 0);
+public:
+    using value_type = typename Op::value_type;
+
+private:
+    std::array<T, Window> m_back{};
+    size_t m_back_count{0};
+    value_type m_back_agg{Op::identity()};
+    std::array<value_type, Window> m_front{};
+    size_t m_front_count{0};
+
+    void turn_over() {
+        value_type agg = Op::identity();
+        for(size_t i = m_back_count; i-- > 0; ) {
+            agg = Op::combine(Op::lift(m_back[i]), agg);
+            m_front[m_front_count++] = agg;
+        }
+        m_back_count = 0;
+        m_back_agg = Op::identity();
+    }
+
+public:
+    /// @brief Appends value, evicting the oldest element when the window is full.
+    void push(const T & value) {
+        if(size() == Window) pop();
+        m_back[m_back_count++] = value;
+        m_back_agg = Op::combine(m_back_agg, Op::lift(value));
+    }
+    /// @brief Evicts the oldest element, the window must not be empty.
+    void pop() {
+        if(m_front_count == 0) turn_over();
+        m_front_count--;
+    }
+
+    /// @brief Aggregate of the window from oldest to newest, identity() when empty.
+    value_type query() const {
+        const value_type front = m_front_count ? m_front[m_front_count - 1] : Op::identity();
+        return Op::combine(front, m_back_agg);
+    }
+
+    void clear() {
+        m_back_count = m_front_count = 0;
+        m_back_agg = Op::identity();
+    }
+    size_t size() const { return m_back_count + m_front_count; }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Window; }
+};
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "logging.hpp"
+
+/// Turns a stream written by Logging in deferred mode back into the text the
+/// synchronous mode would have printed. Arguments are stored in native byte
+/// order, so decode on the same architecture the log was written on.
+class DeferredDecoder {
+public:
+    /// @brief Decode a whole stream into output
+    /// Returns false if the stream is malformed or truncated, output then holds
+    /// every message decoded up to that point.
+    static bool Decode(const std::vector<unsigned char> &input, std::string &output) {
+        const size_t start = sizeof(Logging::deferred_magic);
+        if (input.size() < start || memcmp(input.data(), Logging::deferred_magic, start) != 0) return false;
+        std::unordered_map<uint16_t, Definition> definitions;
+        size_t end = input.size();
+        // Definitions may follow the first message using them when threads race, so collect them first.
+        // A broken record ends the stream, messages before it are still decoded.
+        for (int pass = 0; pass < 2; ++pass) {
+            for (size_t pos = start; pos < end;) {
+                const unsigned char *record = input.data() + pos;
+                const size_t length = record_length(record, end - pos);
+                if (length == 0) {
+                    end = pos;
+                    break;
+                }
+                if (record[0] == 'D' && pass == 0) {
+                    const size_t argc = record[3];
+                    Definition &definition = definitions[read<uint16_t>(record + 1)];
+                    definition.signature.assign(reinterpret_cast<const char *>(record + 6), 2 * argc);
+                    definition.format.assign(reinterpret_cast<const char *>(record + 6 + 2 * argc), length - 6 - 2 * argc);
+                } else if (record[0] == 'M' && pass == 1) {
+                    auto definition = definitions.find(read<uint16_t>(record + 2));
+                    if (definition == definitions.end()) return false;
+                    output += Logging::prefix(static_cast<Logging::Level>(record[1]));
+                    if (!render(definition->second, record + 6, length - 6, output)) return false;
+                    output += "\r\n";
+                }
+                pos += length;
+            }
+        }
+        return end == input.size();
+    }
+
+private:
+    struct Definition {
+        std::string signature;
+        std::string format;
+    };
+
+    struct Argument {
+        char kind{0};
+        long long integer{0};
+        long double floating{0};
+        const void *pointer{nullptr};
+        std::string string;
+    };
+
+    /// Size of the record at data, 0 if it is broken or does not fit into left bytes.
+    static size_t record_length(const unsigned char *data, size_t left) {
+        if (left < 6) return 0;
+        size_t length = 0;
+        if (data[0] == 'D') length = 6 + 2 * size_t(data[3]) + read<uint16_t>(data + 4);
+        else if (data[0] == 'M') length = 6 + read<uint16_t>(data + 4);
+        return length <= left ? length : 0;
+    }
+
+    template <typename V>
+    static V read(const unsigned char *data) {
+        V value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    template <typename Signed, typename Unsigned>
+    static long long read_integer(const unsigned char *data, bool is_signed) {
+        return is_signed ? static_cast<long long>(read<Signed>(data)) : static_cast<long long>(read<Unsigned>(data));
+    }
+
+    static bool next(const Definition &definition, size_t &arg, const unsigned char *&data, const unsigned char *end,
+                     Argument &out) {
+        if (2 * arg >= definition.signature.size()) return false;
+        out.kind = definition.signature[2 * arg];
+        const size_t size = static_cast<unsigned char>(definition.signature[2 * arg + 1]);
+        arg++;
+        if (out.kind == 's') {
+            if (end - data < 2) return false;
+            const size_t length = read<uint16_t>(data);
+            if (static_cast<size_t>(end - data) < 2 + length) return false;
+            out.string.assign(reinterpret_cast<const char *>(data + 2), length);
+            data += 2 + length;
+            return true;
+        }
+        if (static_cast<size_t>(end - data) < size) return false;
+        const bool is_signed = out.kind == 'i';
+        switch (out.kind) {
+            case 'i':
+            case 'u':
+                switch (size) {
+                    case 1: out.integer = read_integer<int8_t, uint8_t>(data, is_signed); break;
+                    case 2: out.integer = read_integer<int16_t, uint16_t>(data, is_signed); break;
+                    case 4: out.integer = read_integer<int32_t, uint32_t>(data, is_signed); break;
+                    case 8: out.integer = read_integer<int64_t, uint64_t>(data, is_signed); break;
+                    default: return false;
+                }
+                break;
+            case 'f':
+                if (size == sizeof(double)) out.floating = read<double>(data);
+                else if (size == sizeof(long double)) out.floating = read<long double>(data);
+                else return false;
+                break;
+            case 'p':
+                if (size != sizeof(const void *)) return false;
+                out.pointer = read<const void *>(data);
+                break;
+            default:
+                return false;
+        }
+        data += size;
+        return true;
+    }
+
+    template <typename V>
+    static void append(std::string &output, const std::string &spec, V value) {
+        char buffer[256];
+        const int length = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+        if (length < 0) return;
+        if (static_cast<size_t>(length) < sizeof(buffer)) {
+            output.append(buffer, length);
+        } else {
+            std::string large(length + 1, '\0');
+            snprintf(large.data(), large.size(), spec.c_str(), value);
+            output.append(large.data(), length);
+        }
+    }
+
+    /// Formats one message, every conversion is printed on its own with the
+    /// length modifier replaced by the one matching the decoded value.
+    static bool render(const Definition &definition, const unsigned char *data, size_t size, std::string &output) {
+        if (definition.signature.empty()) {
+            output += definition.format;
+            return true;
+        }
+        const unsigned char *end = data + size;
+        const std::string &format = definition.format;
+        size_t arg = 0;
+        Argument value;
+        for (size_t i = 0; i < format.size(); ++i) {
+            if (format[i] != '%') {
+                output += format[i];
+                continue;
+            }
+            if (++i < format.size() && format[i] == '%') {
+                output += '%';
+                continue;
+            }
+            std::string spec = "%";
+            while (i < format.size() && strchr("-+ #0", format[i])) spec += format[i++];
+            for (int part = 0; part < 2; ++part) {
+                if (part == 1) {
+                    if (i >= format.size() || format[i] != '.') break;
+                    spec += format[i++];
+                }
+                if (i < format.size() && format[i] == '*') {
+                    if (!next(definition, arg, data, end, value)) return false;
+                    if (part == 0 || value.integer >= 0) spec += std::to_string(value.integer);
+                    else spec.pop_back();
+                    i++;
+                }
+                while (i < format.size() && format[i] >= '0' && format[i] <= '9') spec += format[i++];
+            }
+            size_t bits = 8 * sizeof(int);
+            bool long_double = false;
+            while (i < format.size() && strchr("hljztL", format[i])) {
+                switch (format[i]) {
+                    case 'h': bits = bits == 16 ? 8 : 16; break;
+                    case 'L': long_double = true; break;
+                    default: bits = 64; break;
+                }
+                i++;
+            }
+            if (i >= format.size()) return false;
+            const char conversion = format[i];
+            if (!next(definition, arg, data, end, value)) return false;
+            switch (conversion) {
+                case 'd':
+                case 'i': {
+                    long long integer = value.integer;
+                    if (bits < 64) integer = static_cast<long long>(static_cast<uint64_t>(integer) << (64 - bits)) >> (64 - bits);
+                    append(output, spec + "ll" + conversion, integer);
+                    break;
+                }
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X': {
+                    unsigned long long integer = static_cast<unsigned long long>(value.integer);
+                    if (bits < 64) integer &= (1ULL << bits) - 1;
+                    append(output, spec + "ll" + conversion, integer);
+                    break;
+                }
+                case 'c':
+                    append(output, spec + conversion, static_cast<int>(value.integer));
+                    break;
+                case 's':
+                    append(output, spec + conversion, value.string.c_str());
+                    break;
+                case 'p':
+                    // Logging records the pointer value for %p, never the bytes it points to.
+                    if (value.kind != 'p') return false;
+                    append(output, spec + conversion, value.pointer);
+                    break;
+                default:
+                    if (long_double) append(output, spec + 'L' + conversion, value.floating);
+                    else append(output, spec + conversion, static_cast<double>(value.floating));
+            }
+        }
+        return true;
+    }
+};
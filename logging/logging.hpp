@@ -1,6 +1,56 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <cstdio>
+#include <type_traits>
+#include <utility>
+
+#ifndef LOGGING_MIN_LEVEL
+    #define LOGGING_MIN_LEVEL DEBUG
+#endif
+
+#ifdef LOGGING_DEFERRED
+    #include <array>
+    #include <atomic>
+    #include <cstring>
+
+    #ifndef LOGGING_DEFERRED_FORMATS
+        #define LOGGING_DEFERRED_FORMATS 1024
+    #endif
+    #ifndef LOGGING_DEFERRED_RECORD_BYTES
+        #define LOGGING_DEFERRED_RECORD_BYTES 256
+    #endif
+#endif
+
+#ifdef LOGGING_ASYNC
+    #include <algorithm>
+    #include <atomic>
+    #include <cstring>
+    #include <thread>
+    #include <tuple>
+    #include <unistd.h>
+    #include "../containers/mpmc_queue.hpp"
+
+    #ifndef LOGGING_ASYNC_QUEUE_SIZE
+        #define LOGGING_ASYNC_QUEUE_SIZE 1024
+    #endif
+    #ifndef LOGGING_ASYNC_ARG_BYTES
+        #define LOGGING_ASYNC_ARG_BYTES 96
+    #endif
+#endif
+
+#ifdef LOGGING_FLIGHT_RECORDER
+    #include <atomic>
+    #include "../containers/persistent_ringbuffer.hpp"
+
+    #ifndef LOGGING_FLIGHT_RECORDS
+        #define LOGGING_FLIGHT_RECORDS 1024
+    #endif
+    #ifndef LOGGING_FLIGHT_RECORD_BYTES
+        #define LOGGING_FLIGHT_RECORD_BYTES 384
+    #endif
+#endif
 
 class Logging {
 public:
@@ -18,85 +68,642 @@ public:
         current_level = level;
     }
 
+    /// @brief Lowest level compiled in, select with e.g. -DLOGGING_MIN_LEVEL=INFO
+    static constexpr Level min_level = Level::LOGGING_MIN_LEVEL;
+
+    /// @brief Whether messages of the level are compiled in at all
+    static constexpr bool Enabled(Level level) {
+        return level >= min_level;
+    }
+
+    /// @brief How an argument is passed on: string, pointer, floating, signed or unsigned integer
+    template <typename A>
+    static constexpr char arg_kind() {
+        using D = std::decay_t<A>;
+        if constexpr (std::is_same_v<D, char *> || std::is_same_v<D, const char *>) return 's';
+        else if constexpr (std::is_pointer_v<D> || std::is_null_pointer_v<D>) return 'p';
+        else if constexpr (std::is_floating_point_v<D>) return 'f';
+        else if constexpr (std::is_integral_v<D>) return std::is_signed_v<D> ? 'i' : 'u';
+        else if constexpr (std::is_enum_v<D> && std::is_convertible_v<D, int>)
+            return std::is_signed_v<std::underlying_type_t<D>> ? 'i' : 'u';
+        else return '?';
+    }
+
+    /// @brief printf format string checked against the argument types at compile time
+    /// A message without arguments is printed as it is and therefore not parsed.
+    template <typename... Args>
+    class FormatString {
+        const char *str;
+
+        enum class Length { NONE, HH, H, L, LL, J, Z, T, BIG_L };
+
+        // Not constexpr, so reaching it while checking a format fails the compilation.
+        static void invalid_format(const char *) {}
+
+        static constexpr char kinds[] = {arg_kind<Args>()..., 0};
+        static constexpr size_t sizes[] = {sizeof(std::decay_t<Args>)..., 0};
+
+        static consteval bool integer_fits(size_t size, Length length) {
+            switch (length) {
+                case Length::L: return size == sizeof(long);
+                case Length::LL: return size == sizeof(long long);
+                case Length::J: return size == sizeof(intmax_t);
+                case Length::Z: return size == sizeof(size_t);
+                case Length::T: return size == sizeof(ptrdiff_t);
+                default: return size <= sizeof(int);
+            }
+        }
+
+        static consteval size_t next(size_t arg) {
+            if (arg >= sizeof...(Args)) invalid_format("too few arguments for format");
+            return arg;
+        }
+
+        static consteval void check(const char *format) {
+            size_t arg = 0;
+            for (const char *p = format; *p; ++p) {
+                if (*p != '%') continue;
+                if (*++p == '%') continue;
+                while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') ++p;
+                if (*p == '*') {
+                    arg = next(arg);
+                    if (kinds[arg] != 'i' || sizes[arg] > sizeof(int)) invalid_format("'*' width takes an int");
+                    ++arg;
+                    ++p;
+                }
+                while (*p >= '0' && *p <= '9') ++p;
+                if (*p == '.') {
+                    if (*++p == '*') {
+                        arg = next(arg);
+                        if (kinds[arg] != 'i' || sizes[arg] > sizeof(int)) invalid_format("'*' precision takes an int");
+                        ++arg;
+                        ++p;
+                    }
+                    while (*p >= '0' && *p <= '9') ++p;
+                }
+                Length length = Length::NONE;
+                switch (*p) {
+                    case 'h': length = *++p == 'h' ? (++p, Length::HH) : Length::H; break;
+                    case 'l': length = *++p == 'l' ? (++p, Length::LL) : Length::L; break;
+                    case 'j': length = Length::J; ++p; break;
+                    case 'z': length = Length::Z; ++p; break;
+                    case 't': length = Length::T; ++p; break;
+                    case 'L': length = Length::BIG_L; ++p; break;
+                    default: break;
+                }
+                arg = next(arg);
+                const char kind = kinds[arg];
+                const size_t size = sizes[arg];
+                switch (*p) {
+                    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+                        if (kind != 'i' && kind != 'u') invalid_format("integer conversion needs an integer argument");
+                        if (!integer_fits(size, length)) invalid_format("integer argument size does not match the length modifier");
+                        break;
+                    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                        if (kind != 'f') invalid_format("floating conversion needs a floating point argument");
+                        if ((length == Length::BIG_L) != (size == sizeof(long double))) invalid_format("long double needs %L");
+                        break;
+                    case 's':
+                        if (kind != 's') invalid_format("%s needs a char pointer");
+                        break;
+                    case 'p':
+                        // A char pointer would be copied as a string by the async and deferred modes.
+                        if (kind == 's') invalid_format("%p of a char pointer needs a cast to const void *");
+                        if (kind != 'p') invalid_format("%p needs a pointer");
+                        break;
+                    case '\0':
+                        invalid_format("format ends inside a conversion");
+                        break;
+                    default:
+                        invalid_format("unsupported conversion");
+                }
+                ++arg;
+            }
+            if (arg != sizeof...(Args)) invalid_format("too many arguments for format");
+        }
+
+    public:
+        consteval FormatString(const char *format) : str(format) {
+            if constexpr (sizeof...(Args) > 0) check(format);
+        }
+        constexpr operator const char *() const { return str; }
+    };
+
+    template <typename... Args>
+    using Format = FormatString<std::type_identity_t<Args>...>;
+
+    /// @brief Header of a stream written in deferred mode, followed by the version byte
+    static constexpr char deferred_magic[] = {'L', 'O', 'G', 'D', 1};
+
+#ifdef LOGGING_ASYNC
+    /// @brief What a logging call does when the async queue is full
+    enum class Overflow {
+        DROP,
+        BLOCK,
+    };
+
+    /// @brief Hand messages to a background thread instead of printing them on the caller's thread
+    /// Arguments are copied when logging, strings (char pointers) up to the record capacity.
+    static void StartAsync(Overflow policy = Overflow::DROP) {
+        fflush(stdout);
+        AsyncSink *expected = nullptr;
+        AsyncSink *sink = new AsyncSink(policy);
+        if (!async_sink.compare_exchange_strong(expected, sink)) delete sink;
+    }
+
+    /// @brief Write out queued messages and return to synchronous logging
+    /// No other thread may be logging while this is called.
+    static void StopAsync() {
+        AsyncSink *sink = async_sink.exchange(nullptr);
+        delete sink;
+    }
+
+    /// @brief Number of messages dropped because the async queue was full
+    static size_t DroppedMessages() {
+        return dropped_messages.load(std::memory_order_relaxed);
+    }
+#endif
+
+#ifdef LOGGING_DEFERRED
+    /// @brief Write binary records (format id and raw arguments) to out instead of text
+    /// Formats are only written once per stream, tools/log_decoder turns it back into text.
+    /// No other thread may be logging while this is called.
+    static void StartDeferred(FILE *out) {
+        for (auto &slot : format_table) slot.state.store(SLOT_EMPTY, std::memory_order_relaxed);
+        fwrite(deferred_magic, 1, sizeof(deferred_magic), out);
+        deferred_out.store(out, std::memory_order_release);
+    }
+
+    /// @brief Return to text logging, flushing the deferred stream
+    static void StopDeferred() {
+        if (FILE *out = deferred_out.exchange(nullptr)) fflush(out);
+    }
+#endif
+
+#ifdef LOGGING_FLIGHT_RECORDER
+    /// @brief One message as text with its level prefix, NUL terminated and truncated to fit
+    struct FlightRecord {
+        char text[LOGGING_FLIGHT_RECORD_BYTES];
+    };
+    using FlightRecorder = PersistentRingbuffer<FlightRecord, LOGGING_FLIGHT_RECORDS>;
+
+    /// @brief Keep the last LOGGING_FLIGHT_RECORDS messages in the file at path instead of printing them
+    /// The file survives a crash, tools/flight_recorder prints it. Takes precedence over the other modes.
+    /// @throws std::system_error when the file cannot be opened, see PersistentRingbuffer::open
+    static void StartFlightRecorder(const char *path) {
+        FlightRecorder *expected = nullptr;
+        FlightRecorder *recorder = new FlightRecorder(FlightRecorder::open(path));
+        if (!flight_recorder.compare_exchange_strong(expected, recorder)) delete recorder;
+    }
+
+    /// @brief Return to the previous logging mode, the file keeps its messages
+    /// No other thread may be logging while this is called.
+    static void StopFlightRecorder() {
+        delete flight_recorder.exchange(nullptr);
+    }
+#endif
+
     /// @brief Log a formatted message with info level
     template <typename... Args>
-    static void Info(const char *format, Args... args) {
-        if (current_level <= Level::INFO) {
-            Log(Level::INFO, format, args...);
+    static void Info(Format<Args...> format, Args &&...args) {
+        if constexpr (Enabled(Level::INFO)) {
+            if (current_level <= Level::INFO) {
+                Log(Level::INFO, format, std::forward<Args>(args)...);
+            }
+        }
+    }
+
+    /// @brief Log a message with info level, also one only known at runtime, printed as it is
+    static void Info(const char *message) {
+        if constexpr (Enabled(Level::INFO)) {
+            if (current_level <= Level::INFO) {
+                Log(Level::INFO, message);
+            }
         }
     }
 
     /// @brief Log a formatted message with debug level
     template <typename... Args>
-    static void Debug(const char *format, Args... args) {
-        if (current_level <= Level::DEBUG) {
-            Log(Level::DEBUG, format, args...);
+    static void Debug(Format<Args...> format, Args &&...args) {
+        if constexpr (Enabled(Level::DEBUG)) {
+            if (current_level <= Level::DEBUG) {
+                Log(Level::DEBUG, format, std::forward<Args>(args)...);
+            }
+        }
+    }
+
+    /// @brief Log a message with debug level, also one only known at runtime, printed as it is
+    static void Debug(const char *message) {
+        if constexpr (Enabled(Level::DEBUG)) {
+            if (current_level <= Level::DEBUG) {
+                Log(Level::DEBUG, message);
+            }
         }
     }
 
     /// @brief Log a formatted message with warn level
     template <typename... Args>
-    static void Warning(const char *format, Args... args) {
-        if (current_level <= Level::WARN) {
-            Log(Level::WARN, format, args...);
+    static void Warning(Format<Args...> format, Args &&...args) {
+        if constexpr (Enabled(Level::WARN)) {
+            if (current_level <= Level::WARN) {
+                Log(Level::WARN, format, std::forward<Args>(args)...);
+            }
+        }
+    }
+
+    /// @brief Log a message with warn level, also one only known at runtime, printed as it is
+    static void Warning(const char *message) {
+        if constexpr (Enabled(Level::WARN)) {
+            if (current_level <= Level::WARN) {
+                Log(Level::WARN, message);
+            }
         }
     }
 
     /// @brief Log a formatted message with error level
     template <typename... Args>
-    static void Error(const char *format, Args... args) {
-        if (current_level <= Level::ERROR) {
-            Log(Level::ERROR, format, args...);
+    static void Error(Format<Args...> format, Args &&...args) {
+        if constexpr (Enabled(Level::ERROR)) {
+            if (current_level <= Level::ERROR) {
+                Log(Level::ERROR, format, std::forward<Args>(args)...);
+            }
+        }
+    }
+
+    /// @brief Log a message with error level, also one only known at runtime, printed as it is
+    static void Error(const char *message) {
+        if constexpr (Enabled(Level::ERROR)) {
+            if (current_level <= Level::ERROR) {
+                Log(Level::ERROR, message);
+            }
         }
     }
 
     /// @brief Log a formatted message with fatal level
     template <typename... Args>
-    static void Fatal(const char *format, Args... args) {
-        if (current_level <= Level::FATAL) {
-            Log(Level::FATAL, format, args...);
+    static void Fatal(Format<Args...> format, Args &&...args) {
+        if constexpr (Enabled(Level::FATAL)) {
+            if (current_level <= Level::FATAL) {
+                Log(Level::FATAL, format, std::forward<Args>(args)...);
+            }
+        }
+    }
+
+    /// @brief Log a message with fatal level, also one only known at runtime, printed as it is
+    static void Fatal(const char *message) {
+        if constexpr (Enabled(Level::FATAL)) {
+            if (current_level <= Level::FATAL) {
+                Log(Level::FATAL, message);
+            }
         }
     }
 
 private:
     inline static Level current_level = Level::DEBUG;
 
+    friend class DeferredDecoder;
+
     static void write_newline() {
         printf("\r\n");
     }
 
-    static void write_prefix(Level level) {
+    static const char *prefix(Level level) {
         switch (level) {
             case Level::DEBUG:
-                printf("[DEBUG] ");
-                break;
+                return "[DEBUG] ";
             case Level::INFO:
-                printf("[INFO] ");
-                break;
+                return "[INFO] ";
             case Level::WARN:
-                printf("[WARN] ");
-                break;
+                return "[WARN] ";
             case Level::ERROR:
-                printf("[ERROR] ");
-                break;
+                return "[ERROR] ";
             case Level::FATAL:
-                printf("[FATAL] ");
-                break;
+                return "[FATAL] ";
             default:
-                printf("[UNKNOWN] ");
+                return "[UNKNOWN] ";
         }
     }
 
+    static void write_prefix(Level level) {
+        printf("%s", prefix(level));
+    }
+
     template <typename... Args>
-    static void Log(Level level, const char *format, Args... args) {
+    static void Log(Level level, const char *format, Args &&...args) {
+#ifdef LOGGING_FLIGHT_RECORDER
+        if (FlightRecorder *recorder = flight_recorder.load(std::memory_order_acquire)) {
+            write_flight(*recorder, level, format, args...);
+            return;
+        }
+#endif
+#ifdef LOGGING_DEFERRED
+        if (FILE *out = deferred_out.load(std::memory_order_acquire)) {
+            write_deferred(out, level, format, args...);
+            return;
+        }
+#endif
+#ifdef LOGGING_ASYNC
+        if (AsyncSink *sink = async_sink.load(std::memory_order_acquire)) {
+            sink->enqueue(level, format, args...);
+            return;
+        }
+#endif
         write_prefix(level);
-        printf(format, args...);
+        printf(format, std::forward<Args>(args)...);
         write_newline();
     }
 
-    static void Log(Level level, const char *format) {
+    // The message need not outlive the call, so the other modes copy it as a "%s" argument.
+    static void Log(Level level, const char *message) {
+#ifdef LOGGING_FLIGHT_RECORDER
+        if (FlightRecorder *recorder = flight_recorder.load(std::memory_order_acquire)) {
+            write_flight(*recorder, level, "%s", message);
+            return;
+        }
+#endif
+#ifdef LOGGING_DEFERRED
+        if (FILE *out = deferred_out.load(std::memory_order_acquire)) {
+            write_deferred(out, level, "%s", message);
+            return;
+        }
+#endif
+#ifdef LOGGING_ASYNC
+        if (AsyncSink *sink = async_sink.load(std::memory_order_acquire)) {
+            sink->enqueue(level, "%s", message);
+            return;
+        }
+#endif
         write_prefix(level);
-        printf("%s", format);
+        printf("%s", message);
         write_newline();
     }
+
+#ifdef LOGGING_FLIGHT_RECORDER
+    inline static std::atomic<FlightRecorder *> flight_recorder{nullptr};
+    // The recorder has a single writer, concurrent logging calls take turns on this.
+    inline static std::atomic_flag flight_lock;
+
+    /// Formats into a local record, so the lock is only held for the copy into the file mapping.
+    template <typename... Args>
+    static void write_flight(FlightRecorder &recorder, Level level, const char *format, Args... args) {
+        FlightRecord record{};
+        const int length = snprintf(record.text, sizeof(record.text), "%s", prefix(level));
+        if (length >= 0 && size_t(length) < sizeof(record.text)) {
+            snprintf(record.text + length, sizeof(record.text) - length, format, args...);
+        }
+        while (flight_lock.test_and_set(std::memory_order_acquire)) {
+        }
+        recorder.push_back(record);
+        flight_lock.clear(std::memory_order_release);
+    }
+#endif
+
+#ifdef LOGGING_DEFERRED
+    /// Deferred stream records, integers in native byte order:
+    ///   'D' u16 id, u8 argc, u16 format length, argc pairs of (kind, size), format
+    ///   'M' u8 level, u16 id, u16 payload length, arguments (strings as u16 length and bytes)
+    template <typename A>
+    using deferred_t = std::conditional_t<arg_kind<A>() == 's', const char *,
+                       std::conditional_t<arg_kind<A>() == 'p', const void *,
+                       std::conditional_t<std::is_same_v<std::decay_t<A>, float>, double, std::decay_t<A>>>>;
+
+    template <typename A>
+    static constexpr size_t deferred_min_size = arg_kind<A>() == 's' ? 2 : sizeof(deferred_t<A>);
+
+    template <typename... Args>
+    struct Signature {
+        static constexpr std::array<char, 2 * sizeof...(Args) + 1> value = [] {
+            std::array<char, 2 * sizeof...(Args) + 1> signature{};
+            [[maybe_unused]] size_t i = 0;
+            ((signature[i++] = arg_kind<Args>(), signature[i++] = char(sizeof(deferred_t<Args>))), ...);
+            return signature;
+        }();
+    };
+
+    enum : uint32_t { SLOT_EMPTY, SLOT_WRITING, SLOT_READY };
+
+    struct FormatSlot {
+        std::atomic<uint32_t> state;
+        const char *format;
+        const char *signature;
+    };
+
+    inline static FormatSlot format_table[LOGGING_DEFERRED_FORMATS];
+    inline static std::atomic<FILE *> deferred_out{nullptr};
+
+    static void write_definition(FILE *out, uint16_t id, const char *format, const char *signature, size_t argc) {
+        const uint16_t length = static_cast<uint16_t>(strnlen(format, UINT16_MAX));
+        unsigned char header[6] = {'D'};
+        memcpy(header + 1, &id, 2);
+        header[3] = static_cast<unsigned char>(argc);
+        memcpy(header + 4, &length, 2);
+        flockfile(out);
+        fwrite(header, 1, sizeof(header), out);
+        fwrite(signature, 1, 2 * argc, out);
+        fwrite(format, 1, length, out);
+        funlockfile(out);
+    }
+
+    /// Id of the format and signature pair, the first call writes its definition.
+    /// Returns -1 when all LOGGING_DEFERRED_FORMATS ids are taken, the message is dropped then.
+    static int deferred_id(FILE *out, const char *format, const char *signature, size_t argc) {
+        const uintptr_t hash = reinterpret_cast<uintptr_t>(format) * 31 + reinterpret_cast<uintptr_t>(signature);
+        for (size_t probe = 0; probe < LOGGING_DEFERRED_FORMATS; ++probe) {
+            const size_t id = (hash / alignof(std::max_align_t) + probe) % LOGGING_DEFERRED_FORMATS;
+            FormatSlot &slot = format_table[id];
+            uint32_t state = slot.state.load(std::memory_order_acquire);
+            if (state == SLOT_EMPTY && slot.state.compare_exchange_strong(state, SLOT_WRITING)) {
+                slot.format = format;
+                slot.signature = signature;
+                write_definition(out, static_cast<uint16_t>(id), format, signature, argc);
+                slot.state.store(SLOT_READY, std::memory_order_release);
+                return static_cast<int>(id);
+            }
+            while (state == SLOT_WRITING) state = slot.state.load(std::memory_order_acquire);
+            if (slot.format == format && slot.signature == signature) return static_cast<int>(id);
+        }
+        return -1;
+    }
+
+    template <typename A>
+    static void encode(unsigned char *&cursor, const unsigned char *end, size_t &reserve, const A &arg) {
+        reserve -= deferred_min_size<A>;
+        if constexpr (arg_kind<A>() == 's') {
+            const char *str = arg;
+            if (!str) str = "(null)";
+            const uint16_t length = static_cast<uint16_t>(strnlen(str, end - cursor - reserve - 2));
+            memcpy(cursor, &length, 2);
+            memcpy(cursor + 2, str, length);
+            cursor += 2 + length;
+        } else {
+            const deferred_t<A> value = arg;
+            memcpy(cursor, &value, sizeof(value));
+            cursor += sizeof(value);
+        }
+    }
+
+    template <typename... Args>
+    static void write_deferred(FILE *out, Level level, const char *format, const Args &...args) {
+        constexpr size_t header = 6;
+        constexpr size_t min_size = (deferred_min_size<Args> + ... + 0);
+        static_assert(header + min_size <= LOGGING_DEFERRED_RECORD_BYTES,
+                      "log arguments do not fit LOGGING_DEFERRED_RECORD_BYTES");
+        const int id = deferred_id(out, format, Signature<std::decay_t<Args>...>::value.data(), sizeof...(Args));
+        if (id < 0) return;
+        unsigned char record[LOGGING_DEFERRED_RECORD_BYTES];
+        unsigned char *cursor = record + header;
+        [[maybe_unused]] size_t reserve = min_size;
+        (encode(cursor, record + sizeof(record), reserve, args), ...);
+        const uint16_t id16 = static_cast<uint16_t>(id);
+        const uint16_t payload = static_cast<uint16_t>(cursor - record - header);
+        record[0] = 'M';
+        record[1] = static_cast<unsigned char>(level);
+        memcpy(record + 2, &id16, 2);
+        memcpy(record + 4, &payload, 2);
+        fwrite(record, 1, cursor - record, out);
+    }
+#endif
+
+#ifdef LOGGING_ASYNC
+    /// Message captured on the logging thread. Fixed size arguments are stored
+    /// first, strings are copied behind them and truncated to what fits.
+    struct Record {
+        Level level;
+        const char *format;
+        int (*render)(const Record &, char *, size_t);
+        unsigned char args[LOGGING_ASYNC_ARG_BYTES];
+    };
+
+    template <typename A>
+    static constexpr bool is_string = std::is_same_v<std::decay_t<A>, const char *> ||
+                                      std::is_same_v<std::decay_t<A>, char *>;
+
+    template <typename A>
+    using stored_t = std::conditional_t<is_string<A>, const char *, std::decay_t<A>>;
+
+    template <typename A>
+    static constexpr size_t fixed_size = is_string<A> ? 0 : sizeof(std::decay_t<A>);
+
+    template <typename A>
+    static void store(Record &record, size_t &fixed, size_t &strings, size_t &strings_left, const A &arg) {
+        if constexpr (is_string<A>) {
+            const char *str = arg;
+            if (!str) str = "(null)";
+            strings_left--;
+            size_t length = strnlen(str, sizeof(record.args) - strings - strings_left - 1);
+            memcpy(record.args + strings, str, length);
+            record.args[strings + length] = '\0';
+            strings += length + 1;
+        } else {
+            static_assert(std::is_trivially_copyable_v<A>, "async logging copies arguments byte-wise");
+            memcpy(record.args + fixed, &arg, sizeof(A));
+            fixed += sizeof(A);
+        }
+    }
+
+    template <typename A>
+    static stored_t<A> load(const Record &record, size_t &fixed, size_t &strings) {
+        if constexpr (is_string<A>) {
+            const char *str = reinterpret_cast<const char *>(record.args + strings);
+            strings += strlen(str) + 1;
+            return str;
+        } else {
+            std::decay_t<A> value;
+            memcpy(&value, record.args + fixed, sizeof(value));
+            fixed += sizeof(value);
+            return value;
+        }
+    }
+
+    template <typename... Args>
+    static int render(const Record &record, char *out, size_t size) {
+        if constexpr (sizeof...(Args) == 0) {
+            return snprintf(out, size, "%s", record.format);
+        } else {
+            size_t fixed = 0;
+            size_t strings = (fixed_size<Args> + ...);
+            std::tuple<stored_t<Args>...> values{load<Args>(record, fixed, strings)...};
+            return std::apply([&](auto... value) { return snprintf(out, size, record.format, value...); }, values);
+        }
+    }
+
+    class AsyncSink {
+        MpmcQueue<Record, LOGGING_ASYNC_QUEUE_SIZE> queue;
+        Overflow policy;
+        std::thread worker;
+
+        void run() {
+            static constexpr size_t line_size = 512;
+            char batch[8 * line_size];
+            Record record;
+            for (;;) {
+                queue.pop(record);
+                size_t used = 0;
+                bool stop = false;
+                do {
+                    if (!record.format) {
+                        stop = true;
+                        break;
+                    }
+                    char *line = batch + used;
+                    int length = snprintf(line, line_size, "%s", prefix(record.level));
+                    int body = record.render(record, line + length, line_size - 2 - length);
+                    if (body > 0) length += std::min(body, int(line_size) - 3 - length);
+                    line[length++] = '\r';
+                    line[length++] = '\n';
+                    used += length;
+                } while (used + line_size <= sizeof(batch) && queue.try_pop(record));
+                write_all(batch, used);
+                if (stop) return;
+            }
+        }
+
+        static void write_all(const char *data, size_t size) {
+            while (size > 0) {
+                ssize_t written = write(STDOUT_FILENO, data, size);
+                if (written <= 0) return;
+                data += written;
+                size -= written;
+            }
+        }
+
+    public:
+        explicit AsyncSink(Overflow _policy) : policy(_policy), worker([this] { run(); }) {}
+        ~AsyncSink() {
+            Record stop{};
+            queue.push(stop);
+            worker.join();
+        }
+
+        template <typename... Args>
+        void enqueue(Level level, const char *format, const Args &...args) {
+            static_assert((fixed_size<Args> + ... + 0) + (size_t(is_string<Args>) + ... + 0) <= LOGGING_ASYNC_ARG_BYTES,
+                          "log arguments do not fit LOGGING_ASYNC_ARG_BYTES");
+            Record record;
+            record.level = level;
+            record.format = format;
+            record.render = &render<Args...>;
+            [[maybe_unused]] size_t fixed = 0;
+            [[maybe_unused]] size_t strings = (fixed_size<Args> + ... + 0);
+            [[maybe_unused]] size_t strings_left = (size_t(is_string<Args>) + ... + 0);
+            (store(record, fixed, strings, strings_left, args), ...);
+            if (policy == Overflow::BLOCK) {
+                queue.push(record);
+            } else if (!queue.try_push(record)) {
+                dropped_messages.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    inline static std::atomic<AsyncSink *> async_sink{nullptr};
+    inline static std::atomic<size_t> dropped_messages{0};
+#endif
 };
+
+/// Like the Logging calls, but the arguments are not even evaluated for levels
+/// compiled out by LOGGING_MIN_LEVEL.
+#define LOG_DEBUG(...) do { if constexpr (Logging::Enabled(Logging::Level::DEBUG)) Logging::Debug(__VA_ARGS__); } while (0)
+#define LOG_INFO(...) do { if constexpr (Logging::Enabled(Logging::Level::INFO)) Logging::Info(__VA_ARGS__); } while (0)
+#define LOG_WARNING(...) do { if constexpr (Logging::Enabled(Logging::Level::WARN)) Logging::Warning(__VA_ARGS__); } while (0)
+#define LOG_ERROR(...) do { if constexpr (Logging::Enabled(Logging::Level::ERROR)) Logging::Error(__VA_ARGS__); } while (0)
+#define LOG_FATAL(...) do { if constexpr (Logging::Enabled(Logging::Level::FATAL)) Logging::Fatal(__VA_ARGS__); } while (0)
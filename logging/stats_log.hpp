@@ -0,0 +1,53 @@
+#pragma once
+
+#include "logging.hpp"
+#include "../containers/container_stats.hpp"
+
+/// @brief Layout of a LogStats message
+enum class StatsFormat {
+    TEXT,
+    JSON,
+};
+
+/// @brief Longest name LogStats keeps whole in every logging mode
+inline constexpr size_t stats_name_max = 23;
+
+/// @brief Longest message format prints for a name of stats_name_max characters
+/// Each counter takes at most 20 digits.
+consteval size_t stats_message_max(const char *format) {
+    size_t length = 0;
+    for (const char *p = format; *p; ++p) {
+        if (*p != '%') {
+            length++;
+            continue;
+        }
+        while (*p != 's' && *p != 'u') ++p;
+        length += *p == 's' ? stats_name_max : 20;
+    }
+    return length;
+}
+
+#ifdef LOGGING_ASYNC
+static_assert(3 * sizeof(size_t) + 6 * sizeof(unsigned long long) + stats_name_max + 1 <= LOGGING_ASYNC_ARG_BYTES,
+              "LogStats arguments do not fit LOGGING_ASYNC_ARG_BYTES");
+#endif
+#ifdef LOGGING_FLIGHT_RECORDER
+static_assert(sizeof("[INFO] ") - 1 + stats_message_max(ContainerStats::json_format) < LOGGING_FLIGHT_RECORD_BYTES &&
+              sizeof("[INFO] ") - 1 + stats_message_max(ContainerStats::text_format) < LOGGING_FLIGHT_RECORD_BYTES,
+              "LogStats messages do not fit LOGGING_FLIGHT_RECORD_BYTES");
+#endif
+
+/// @brief Log a container's stats snapshot with info level, e.g. LogStats("rx", ring.stats())
+/// The counters are passed as separate arguments, so async and deferred records stay small.
+inline void LogStats(const char *name, const ContainerStats &stats, StatsFormat format = StatsFormat::TEXT) {
+    const unsigned long long pushes = stats.pushes, pops = stats.pops, overwrites = stats.overwrites,
+                             drops = stats.drops, allocations = stats.allocations,
+                             deallocations = stats.deallocations;
+    if (format == StatsFormat::JSON) {
+        Logging::Info(ContainerStats::json_format, name, stats.size, stats.capacity, stats.high_water,
+                      pushes, pops, overwrites, drops, allocations, deallocations);
+    } else {
+        Logging::Info(ContainerStats::text_format, name, stats.size, stats.capacity, stats.high_water,
+                      pushes, pops, overwrites, drops, allocations, deallocations);
+    }
+}
@@ -0,0 +1,122 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "broadcast_ringbuffer.hpp"
+
+using Ring = BroadcastRingbuffer<int, 4>;
+
+TEST(BroadcastRingbuffer, every_reader_sees_every_element) {
+    Ring ring;
+    Ring::Reader first = ring.subscribe();
+    Ring::Reader second = ring.subscribe();
+    int value{0};
+    EXPECT_EQ(first.try_read(value), Ring::ReadResult::EMPTY);
+    for(int i = 0; i < 3; ++i) ring.push_back(i);
+    EXPECT_EQ(first.available(), 3u);
+    for(int i = 0; i < 3; ++i) {
+        EXPECT_EQ(first.try_read(value), Ring::ReadResult::OK);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(first.try_read(value), Ring::ReadResult::EMPTY);
+    EXPECT_EQ(second.try_read(value), Ring::ReadResult::OK);
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(second.available(), 2u);
+}
+
+TEST(BroadcastRingbuffer, subscribe_starts_at_new_or_oldest) {
+    Ring ring;
+    for(int i = 0; i < 6; ++i) ring.push_back(i);
+    int value{0};
+    Ring::Reader latest = ring.subscribe();
+    EXPECT_EQ(latest.try_read(value), Ring::ReadResult::EMPTY);
+    Ring::Reader oldest = ring.subscribe_oldest();
+    EXPECT_EQ(oldest.available(), 3u);
+    EXPECT_EQ(oldest.try_read(value), Ring::ReadResult::OK);
+    EXPECT_EQ(value, 3);
+}
+
+TEST(BroadcastRingbuffer, lapped_reader_skips_ahead) {
+    Ring ring;
+    Ring::Reader slow = ring.subscribe();
+    Ring::Reader fast = ring.subscribe();
+    int value{0};
+    for(int i = 0; i < 10; ++i) {
+        ring.push_back(i);
+        EXPECT_EQ(fast.try_read(value), Ring::ReadResult::OK);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(slow.try_read(value), Ring::ReadResult::LAPPED);
+    EXPECT_EQ(slow.lost(), 7u);
+    for(int i = 7; i < 10; ++i) {
+        EXPECT_EQ(slow.try_read(value), Ring::ReadResult::OK);
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_EQ(slow.try_read(value), Ring::ReadResult::EMPTY);
+    EXPECT_EQ(fast.lost(), 0u);
+}
+
+struct Sample {
+    uint64_t index;
+    uint64_t check;
+};
+
+TEST(BroadcastRingbuffer, concurrent_readers_see_whole_elements_in_order) {
+    constexpr uint64_t count = 100000;
+    BroadcastRingbuffer<Sample, 64> ring;
+    std::vector<BroadcastRingbuffer<Sample, 64>::Reader> readers(3, ring.subscribe());
+    std::vector<uint64_t> received(readers.size(), 0);
+    // Not std::vector<bool>, whose flags share a word between the threads.
+    std::vector<char> consistent(readers.size(), true);
+    std::vector<std::thread> threads;
+    for(size_t r = 0; r < readers.size(); ++r) {
+        threads.emplace_back([&, r] {
+            uint64_t next = 0;
+            bool ordered = true;
+            Sample sample;
+            while(next < count) {
+                switch(readers[r].try_read(sample)) {
+                case BroadcastRingbuffer<Sample, 64>::ReadResult::OK:
+                    ordered = ordered && sample.check == ~sample.index && sample.index >= next;
+                    next = sample.index + 1;
+                    received[r]++;
+                    break;
+                case BroadcastRingbuffer<Sample, 64>::ReadResult::LAPPED:
+                    break;
+                case BroadcastRingbuffer<Sample, 64>::ReadResult::EMPTY:
+                    std::this_thread::yield();
+                    break;
+                }
+            }
+            consistent[r] = ordered;
+        });
+    }
+    for(uint64_t i = 0; i < count; ++i) {
+        ring.push_back({i, ~i});
+        if(i % 16 == 0) std::this_thread::yield();
+    }
+    for(std::thread & thread : threads) thread.join();
+    for(size_t r = 0; r < readers.size(); ++r) {
+        EXPECT_TRUE(consistent[r]);
+        EXPECT_EQ(received[r] + readers[r].lost(), count);
+    }
+}
@@ -0,0 +1,135 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <string>
+#include <vector>
+#include "channel.hpp"
+
+using IntChannel = Channel<int, 4>;
+
+template<size_t N>
+static Task produce(Channel<int, N> & channel, int count, std::vector<std::string> & log) {
+    for(int i = 0; i < count; ++i) {
+        EXPECT_TRUE(co_await channel.push(i));
+        log.push_back("pushed " + std::to_string(i));
+    }
+    channel.close();
+}
+
+template<size_t N>
+static Task consume(Channel<int, N> & channel, std::vector<int> & received) {
+    while(std::optional<int> value = co_await channel.pop()) received.push_back(*value);
+}
+
+TEST(Channel, producer_suspends_when_full) {
+    Executor executor;
+    IntChannel channel(executor);
+    std::vector<std::string> log;
+    executor.spawn(produce(channel, 5, log));
+    executor.run();
+    // Three fit into Ringbuffer<int, 4>, the fourth push waits for room.
+    EXPECT_EQ(log.size(), 3u);
+    EXPECT_EQ(channel.size(), 3u);
+    EXPECT_EQ(executor.tasks(), 1u);
+    EXPECT_EQ(channel.try_pop(), 0);
+    executor.run();
+    EXPECT_EQ(log.size(), 4u);
+    EXPECT_EQ(channel.size(), 3u);
+}
+
+TEST(Channel, consumer_suspends_when_empty) {
+    Executor executor;
+    IntChannel channel(executor);
+    std::vector<int> received;
+    executor.spawn(consume(channel, received));
+    executor.run();
+    EXPECT_EQ(executor.tasks(), 1u);
+    EXPECT_TRUE(channel.try_push(7));
+    EXPECT_TRUE(channel.empty()); // handed to the waiting consumer directly
+    executor.run();
+    EXPECT_EQ(received, (std::vector<int>{7}));
+    channel.close();
+    executor.run();
+    EXPECT_EQ(executor.tasks(), 0u);
+    EXPECT_FALSE(channel.try_push(8));
+}
+
+TEST(Channel, rendezvous_without_buffer) {
+    Executor executor;
+    Channel<int, 1> channel(executor);
+    EXPECT_EQ(channel.capacity(), 0u);
+    std::vector<std::string> log;
+    executor.spawn(produce(channel, 3, log));
+    executor.run();
+    EXPECT_TRUE(log.empty()); // waits for a consumer
+    std::vector<int> received;
+    executor.spawn(consume(channel, received));
+    executor.run();
+    EXPECT_EQ(received, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(log.size(), 3u);
+    EXPECT_EQ(executor.tasks(), 0u);
+}
+
+TEST(Channel, close_drains_buffer_first) {
+    Executor executor;
+    IntChannel channel(executor);
+    EXPECT_TRUE(channel.try_push(1));
+    EXPECT_TRUE(channel.try_push(2));
+    channel.close();
+    std::vector<int> received;
+    executor.spawn(consume(channel, received));
+    executor.run();
+    EXPECT_EQ(received, (std::vector<int>{1, 2}));
+    EXPECT_EQ(executor.tasks(), 0u);
+}
+
+static Task square(IntChannel & in, Channel<long, 2> & out) {
+    while(std::optional<int> value = co_await in.pop()) co_await out.push(long(*value) * *value);
+    out.close();
+}
+
+static Task sum(Channel<long, 2> & in, long & total) {
+    while(std::optional<long> value = co_await in.pop()) total += *value;
+}
+
+TEST(Channel, pipeline) {
+    Executor executor;
+    IntChannel numbers(executor);
+    Channel<long, 2> squares(executor);
+    std::vector<std::string> log;
+    long total = 0;
+    executor.spawn(sum(squares, total));
+    executor.spawn(square(numbers, squares));
+    executor.spawn(produce(numbers, 1000, log));
+    executor.run();
+    EXPECT_EQ(total, 332833500L);
+    EXPECT_EQ(executor.tasks(), 0u);
+}
+
+TEST(Channel, blocked_tasks_destroyed_with_executor) {
+    std::vector<int> received;
+    Executor executor;
+    IntChannel channel(executor);
+    executor.spawn(consume(channel, received));
+    executor.spawn(consume(channel, received));
+    executor.run();
+    EXPECT_EQ(executor.tasks(), 2u);
+}
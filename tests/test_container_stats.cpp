@@ -0,0 +1,108 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <gtest/gtest.h>
+#define USE_ITERATORS
+#include <new>
+#include "containers/llist.hpp"
+#include "containers/ringbuffer.hpp"
+
+static_assert(sizeof(Ringbuffer<int, 8>) == sizeof(Ringbuffer<int, 8, NoStats>));
+static_assert(sizeof(LList<int>) == 3 * sizeof(void *));
+
+TEST(ContainerStats, ringbuffer_counts) {
+    Ringbuffer<int, 5, CountingStats> ring;
+    for(int i = 0; i < 6; ++i) ring.push_back(i);
+    ring.pop_front();
+    ring.consume(2);
+    const ContainerStats stats = ring.stats();
+    EXPECT_EQ(stats.size, 1u);
+    EXPECT_EQ(stats.capacity, 4u);
+    EXPECT_EQ(stats.high_water, 4u);
+    EXPECT_EQ(stats.pushes, 6u);
+    EXPECT_EQ(stats.overwrites, 2u);
+    EXPECT_EQ(stats.pops, 3u);
+    EXPECT_EQ(stats.pushes - stats.pops - stats.overwrites, stats.size);
+}
+
+TEST(ContainerStats, ringbuffer_bulk_push) {
+    Ringbuffer<int, 5, CountingStats> ring;
+    ring.push_back(0);
+    ring.push_back(1);
+    const int items[] = {2, 3, 4, 5, 6, 7};
+    ring.push_back(std::span<const int>(items));
+    const ContainerStats stats = ring.stats();
+    EXPECT_EQ(stats.pushes, 8u);
+    EXPECT_EQ(stats.overwrites, 4u);
+    EXPECT_EQ(stats.pops, 0u);
+    EXPECT_EQ(stats.size, 4u);
+    EXPECT_EQ(ring.front(), 4);
+    ring.clear();
+    EXPECT_EQ(ring.stats().pops, 4u);
+}
+
+TEST(ContainerStats, ringbuffer_without_stats) {
+    Ringbuffer<int, 5> ring;
+    ring.push_back(1);
+    const ContainerStats stats = ring.stats();
+    EXPECT_EQ(stats.size, 1u);
+    EXPECT_EQ(stats.capacity, 4u);
+    EXPECT_EQ(stats.pushes, 0u);
+}
+
+TEST(ContainerStats, llist_counts) {
+    LList<int, std::allocator<int>, CountingStats> list{1, 2, 3};
+    list.pop_front();
+    list.push_front(0);
+    list.erase(list.begin());
+    LList<int, std::allocator<int>, CountingStats> other{4, 5};
+    list.splice(list.end(), other);
+    ContainerStats stats = list.stats();
+    EXPECT_EQ(stats.size, 4u);
+    EXPECT_EQ(stats.high_water, 4u);
+    EXPECT_EQ(stats.pushes, 6u);
+    EXPECT_EQ(stats.pops, 2u);
+    EXPECT_EQ(stats.allocations, 4u);
+    EXPECT_EQ(stats.deallocations, 2u);
+    EXPECT_EQ(other.stats().pops, 2u);
+    list.clear();
+    stats = list.stats();
+    EXPECT_EQ(stats.pops, 6u);
+    EXPECT_EQ(stats.deallocations, 6u); // including the nodes spliced from other
+}
+
+template<class T>
+struct FailingAllocator {
+    using value_type = T;
+    FailingAllocator() = default;
+    template<class U> FailingAllocator(const FailingAllocator<U> &) {}
+    T * allocate(size_t) { throw std::bad_alloc(); }
+    void deallocate(T *, size_t) {}
+    bool operator==(const FailingAllocator &) const { return true; }
+};
+
+TEST(ContainerStats, llist_drops) {
+    LList<int, FailingAllocator<int>, CountingStats> list;
+    EXPECT_THROW(list.push_back(1), std::bad_alloc);
+    const ContainerStats stats = list.stats();
+    EXPECT_EQ(stats.drops, 1u);
+    EXPECT_EQ(stats.pushes, 0u);
+    EXPECT_EQ(stats.allocations, 0u);
+}
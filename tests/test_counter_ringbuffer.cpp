@@ -0,0 +1,79 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#define USE_ITERATORS
+#include "counter_ringbuffer.hpp"
+
+TEST(CounterRingbuffer, push_back_pop_back_behaviour) {
+    CounterRingbuffer<int, 8> ring;
+    ring.push_back(1);
+    ring.push_back(2);
+    ring.push_back(3);
+    EXPECT_EQ(ring.front(), 1);
+    EXPECT_EQ(ring.back(), 3);
+    EXPECT_EQ(ring.size(), (size_t) 3);
+    ring.pop_back();
+    EXPECT_EQ(ring.back(), 2);
+    ring.pop_front();
+    EXPECT_EQ(ring.front(), 2);
+    ring.pop_back();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(CounterRingbuffer, uses_all_slots) {
+    CounterRingbuffer<int, 4> ring;
+    EXPECT_EQ(ring.capacity(), (size_t) 4);
+    for(int i = 0; i < 4; ++i) ring.push_back(i);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.size(), (size_t) 4);
+    EXPECT_EQ(ring.front(), 0);
+    EXPECT_EQ(ring.back(), 3);
+}
+
+TEST(CounterRingbuffer, round_and_round) {
+    CounterRingbuffer<int, 4> ring;
+    for(int i = 0; i < 11; ++i) ring.push_back(i);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.front(), 7);
+    EXPECT_EQ(ring.back(), 10);
+    for(int i = 0; i < 11; ++i) ring.push_front(i);
+    EXPECT_EQ(ring.front(), 10);
+    EXPECT_EQ(ring.back(), 7);
+}
+
+TEST(CounterRingbuffer, push_front_below_zero) {
+    CounterRingbuffer<int, 8> ring;
+    ring.push_front(1);
+    ring.push_front(2);
+    EXPECT_EQ(ring.size(), (size_t) 2);
+    EXPECT_EQ(ring.front(), 2);
+    EXPECT_EQ(ring.back(), 1);
+    EXPECT_EQ(ring[0], 2);
+    EXPECT_EQ(ring[-1], 1);
+}
+
+TEST(CounterRingbuffer, iterators) {
+    CounterRingbuffer<int, 8> ring = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int j = 2;
+    for(auto value : ring) {
+        EXPECT_EQ(value, j++);
+    }
+    EXPECT_EQ(j, 10);
+}
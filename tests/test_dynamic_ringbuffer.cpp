@@ -0,0 +1,138 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "dynamic_ringbuffer.hpp"
+#include <memory>
+#include <string>
+
+using Growth = DynamicRingbuffer<int>::Growth;
+
+TEST(DynamicRingbuffer, allocates_lazily) {
+    DynamicRingbuffer<int> ring;
+    EXPECT_EQ(ring.capacity(), (size_t) 0);
+    EXPECT_TRUE(ring.empty());
+    ring.push_back(1);
+    EXPECT_EQ(ring.capacity(), (size_t) 8);
+    EXPECT_EQ(ring.front(), 1);
+}
+
+TEST(DynamicRingbuffer, growth_keeps_order_across_wrap) {
+    DynamicRingbuffer<int> ring(Growth{4, 64, false});
+    for(int i = 0; i < 4; ++i) ring.push_back(i);
+    ring.pop_front();
+    ring.pop_front();
+    ring.push_back(4);
+    ring.push_back(5);
+    // 2..5 wrapped around the end of the storage, the next push doubles it
+    EXPECT_EQ(ring.read_segments().second.size(), (size_t) 2);
+    ring.push_back(6);
+    EXPECT_EQ(ring.capacity(), (size_t) 8);
+    ring.push_front(1);
+    for(size_t i = 0; i < ring.size(); ++i) EXPECT_EQ(ring[i], (int) i + 1);
+}
+
+TEST(DynamicRingbuffer, overwrites_at_max_capacity) {
+    DynamicRingbuffer<int> ring(Growth{2, 6, false});
+    for(int i = 0; i < 10; ++i) ring.push_back(i);
+    EXPECT_EQ(ring.capacity(), (size_t) 6);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.front(), 4);
+    EXPECT_EQ(ring.back(), 9);
+    ring.push_front(3);
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_EQ(ring.back(), 8);
+}
+
+TEST(DynamicRingbuffer, shrinks_when_occupancy_is_low) {
+    DynamicRingbuffer<int> ring(Growth{4, 1024, true});
+    for(int i = 0; i < 64; ++i) ring.push_back(i);
+    EXPECT_EQ(ring.capacity(), (size_t) 64);
+    while(ring.size() > 2) ring.pop_front();
+    EXPECT_EQ(ring.capacity(), (size_t) 4);
+    EXPECT_EQ(ring.front(), 62);
+    EXPECT_EQ(ring.back(), 63);
+}
+
+TEST(DynamicRingbuffer, shrink_to_fit_releases_idle_storage) {
+    DynamicRingbuffer<int> ring;
+    ring.reserve(100);
+    EXPECT_EQ(ring.capacity(), (size_t) 100);
+    ring.push_back(1);
+    ring.pop_front();
+    ring.shrink_to_fit();
+    EXPECT_EQ(ring.capacity(), (size_t) 0);
+    ring.push_back(2);
+    EXPECT_EQ(ring.front(), 2);
+}
+
+TEST(DynamicRingbuffer, relocates_non_trivial_items) {
+    auto item = std::make_shared<int>(5);
+    {
+        DynamicRingbuffer<std::shared_ptr<int>> ring(DynamicRingbuffer<std::shared_ptr<int>>::Growth{2, 32, false});
+        for(int i = 0; i < 3; ++i) ring.push_back(item);
+        ring.pop_front();
+        for(int i = 0; i < 10; ++i) ring.push_back(item);
+        EXPECT_EQ(item.use_count(), 13);
+        ring.push_back(std::make_shared<int>(7));
+        EXPECT_EQ(*ring.back(), 7);
+    }
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(DynamicRingbuffer, move) {
+    DynamicRingbuffer<std::string> ring;
+    ring.push_back("a");
+    ring.push_back("b");
+    DynamicRingbuffer<std::string> other(std::move(ring));
+    EXPECT_EQ(ring.capacity(), (size_t) 0);
+    EXPECT_EQ(other.back(), "b");
+    ring = std::move(other);
+    EXPECT_EQ(ring.front(), "a");
+    EXPECT_EQ(ring.size(), (size_t) 2);
+}
+
+TEST(DynamicRingbuffer, push_own_element_when_growing) {
+    using Strings = DynamicRingbuffer<std::string>;
+    Strings ring(Strings::Growth{2, 64, false});
+    ring.push_back(std::string(32, 'a'));
+    ring.push_back(std::string(32, 'b'));
+    ring.push_back(ring.front());   // relocates, front() lived in the freed storage
+    EXPECT_EQ(ring.capacity(), (size_t) 4);
+    ring.push_back(std::string(32, 'c'));
+    ring.push_front(ring.back());   // relocates again
+    EXPECT_EQ(ring.capacity(), (size_t) 8);
+    EXPECT_EQ(ring.size(), (size_t) 5);
+    EXPECT_EQ(ring[0], std::string(32, 'c'));
+    EXPECT_EQ(ring[1], std::string(32, 'a'));
+    EXPECT_EQ(ring[3], std::string(32, 'a'));
+}
+
+TEST(DynamicRingbuffer, push_own_element_when_full) {
+    using Strings = DynamicRingbuffer<std::string>;
+    Strings ring(Strings::Growth{2, 2, false});
+    ring.push_back(std::string(32, 'a'));
+    ring.push_back(std::string(32, 'b'));
+    ring.push_back(ring.front());   // overwrites front() itself
+    EXPECT_EQ(ring.size(), (size_t) 2);
+    EXPECT_EQ(ring.front(), std::string(32, 'b'));
+    EXPECT_EQ(ring.back(), std::string(32, 'a'));
+    ring.push_front(ring.back());   // overwrites back() itself
+    EXPECT_EQ(ring.front(), std::string(32, 'a'));
+    EXPECT_EQ(ring.back(), std::string(32, 'b'));
+}
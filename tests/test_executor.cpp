@@ -0,0 +1,61 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "executor.hpp"
+
+static Task record(Executor & executor, std::vector<std::string> & log, std::string name) {
+    log.push_back(name + " start");
+    co_await executor.yield();
+    log.push_back(name + " end");
+}
+
+TEST(Executor, runs_spawned_tasks_in_order) {
+    Executor executor;
+    std::vector<std::string> log;
+    executor.spawn(record(executor, log, "a"));
+    executor.spawn(record(executor, log, "b"));
+    EXPECT_TRUE(log.empty());
+    EXPECT_EQ(executor.tasks(), 2u);
+    EXPECT_EQ(executor.run(), 4u);
+    EXPECT_EQ(log, (std::vector<std::string>{"a start", "b start", "a end", "b end"}));
+    EXPECT_EQ(executor.tasks(), 0u);
+    EXPECT_FALSE(executor.run_one());
+}
+
+static Task hold(std::shared_ptr<int> resource, std::suspend_always forever) {
+    co_await forever;
+    (void)resource;
+}
+
+TEST(Executor, destroys_suspended_and_unspawned_tasks) {
+    auto resource = std::make_shared<int>(1);
+    {
+        Executor executor;
+        executor.spawn(hold(resource, {}));
+        executor.run();
+        EXPECT_EQ(executor.tasks(), 1u);
+        Task unspawned = hold(resource, {});
+        EXPECT_EQ(resource.use_count(), 3);
+    }
+    EXPECT_EQ(resource.use_count(), 1);
+}
@@ -0,0 +1,130 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#define USE_ITERATORS
+#include "intrusive_list.hpp"
+#include <vector>
+
+namespace {
+
+struct ByAge {};
+struct ByPriority {};
+
+struct Connection : IntrusiveHook<ByAge>, IntrusiveHook<ByPriority> {
+    int id;
+    explicit Connection(int _id) : id(_id) {}
+};
+
+struct Timer : IntrusiveHook<> {
+    int deadline;
+    explicit Timer(int _deadline) : deadline(_deadline) {}
+};
+
+std::vector<int> deadlines(IntrusiveList<Timer> & list) {
+    std::vector<int> result;
+    for(Timer & timer : list) result.push_back(timer.deadline);
+    return result;
+}
+
+}
+
+TEST(IntrusiveList, push_pop_without_copies) {
+    Timer a(1), b(2), c(3);
+    IntrusiveList<Timer> list;
+    EXPECT_TRUE(list.empty());
+    list.push_back(b);
+    list.push_back(c);
+    list.push_front(a);
+    EXPECT_EQ(&list.front(), &a);
+    EXPECT_EQ(&list.back(), &c);
+    EXPECT_EQ(list.size(), (size_t) 3);
+    list.pop_front();
+    EXPECT_FALSE(a.is_linked());
+    list.pop_back();
+    EXPECT_EQ(deadlines(list), (std::vector<int>{2}));
+}
+
+TEST(IntrusiveList, unlink_from_anywhere) {
+    std::vector<Timer> timers{Timer(0), Timer(1), Timer(2), Timer(3)};
+    IntrusiveList<Timer> list;
+    for(Timer & timer : timers) list.push_back(timer);
+    timers[2].unlink();
+    IntrusiveList<Timer>::remove(timers[0]);
+    EXPECT_EQ(deadlines(list), (std::vector<int>{1, 3}));
+    timers[0].unlink(); // already unlinked
+    EXPECT_EQ(list.size(), (size_t) 2);
+}
+
+TEST(IntrusiveList, destroyed_object_unlinks_itself) {
+    IntrusiveList<Timer> list;
+    Timer keep(1);
+    list.push_back(keep);
+    {
+        Timer temporary(2);
+        list.push_back(temporary);
+        EXPECT_EQ(list.size(), (size_t) 2);
+    }
+    EXPECT_EQ(deadlines(list), (std::vector<int>{1}));
+}
+
+TEST(IntrusiveList, object_on_two_lists) {
+    Connection first(1), second(2);
+    IntrusiveList<Connection, ByAge> by_age;
+    IntrusiveList<Connection, ByPriority> by_priority;
+    by_age.push_back(first);
+    by_age.push_back(second);
+    by_priority.push_back(second);
+    by_priority.push_back(first);
+    EXPECT_EQ(by_age.front().id, 1);
+    EXPECT_EQ(by_priority.front().id, 2);
+    IntrusiveList<Connection, ByAge>::remove(first);
+    EXPECT_EQ(by_age.front().id, 2);
+    EXPECT_EQ(by_priority.back().id, 1);
+}
+
+TEST(IntrusiveList, insert_erase_iterators) {
+    Timer a(1), b(2), c(3);
+    IntrusiveList<Timer> list;
+    list.push_back(a);
+    list.push_back(c);
+    auto it = list.insert(IntrusiveList<Timer>::iterator_to(c), b);
+    EXPECT_EQ(it->deadline, 2);
+    EXPECT_EQ(deadlines(list), (std::vector<int>{1, 2, 3}));
+    it = list.erase(list.begin());
+    EXPECT_EQ(&*it, &b);
+    --it;
+    EXPECT_TRUE(it == list.end());
+    EXPECT_EQ(deadlines(list), (std::vector<int>{2, 3}));
+}
+
+TEST(IntrusiveList, move_and_splice) {
+    Timer a(1), b(2), c(3);
+    IntrusiveList<Timer> list;
+    list.push_back(a);
+    list.push_back(b);
+    IntrusiveList<Timer> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    IntrusiveList<Timer> other;
+    other.push_back(c);
+    moved.splice_back(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(deadlines(moved), (std::vector<int>{1, 2, 3}));
+    moved.clear();
+    EXPECT_FALSE(b.is_linked());
+}
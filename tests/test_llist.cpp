@@ -19,6 +19,9 @@ Containers. If not, see <https://www.gnu.org/licenses/>.
 #include <gtest/gtest.h>
 #define USE_ITERATORS
 #include "llist.hpp"
+#include <memory>
+#include <string>
+#include <vector>
 
 TEST(LList, push_back_pop_back_behaviour) {
     LList<int> list;
@@ -128,3 +131,144 @@ TEST(LList, range) {
         EXPECT_EQ(value, expected[idx++]);
     }
 }
+TEST(LList, iterate_after_pop) {
+    LList<int> list{1,2,3,4,5};
+    list.pop_back();
+    list.pop_front();
+    int expected{2};
+    for(auto value : list) {
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, 5);
+}
+
+TEST(LList, move_only_items) {
+    LList<std::unique_ptr<int>> list;
+    list.push_back(std::make_unique<int>(1));
+    list.emplace_back(new int(2));
+    list.emplace_front(new int(0));
+    EXPECT_EQ(*list.front(), 0);
+    EXPECT_EQ(*list.back(), 2);
+    auto first = std::move(list.front());
+    list.pop_front();
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(*list.front(), 1);
+}
+
+TEST(LList, move_constructor_and_assignment) {
+    LList<std::string> list;
+    list.emplace_back(2, 'x');
+    list.push_back("y");
+    LList<std::string> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(moved.front(), "xx");
+    EXPECT_EQ(moved.back(), "y");
+    LList<std::string> assigned{"z"};
+    assigned = std::move(moved);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(assigned.front(), "xx");
+}
+
+template<class T>
+static std::vector<T> contents(LList<T> & list) {
+    std::vector<T> result;
+    for(auto value : list) result.push_back(value);
+    return result;
+}
+
+TEST(LList, size_is_tracked) {
+    LList<int> list{1, 2, 3};
+    EXPECT_EQ(list.size(), (size_t) 3);
+    list.pop_front();
+    list.emplace_front(0);
+    list.push_back(4);
+    list.pop_back();
+    EXPECT_EQ(list.size(), (size_t) 3);
+    list.clear();
+    EXPECT_EQ(list.size(), (size_t) 0);
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(LList, insert_erase_at_iterator) {
+    LList<int> list{1, 3, 5};
+    auto it = list.begin();
+    ++it;
+    it = list.insert(it, 2);
+    EXPECT_EQ(*it, 2);
+    list.insert(list.end(), 6);
+    list.insert(list.begin(), 0);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 1, 2, 3, 5, 6}));
+    it = list.erase(it);
+    EXPECT_EQ(*it, 3);
+    it = list.erase(it, list.end());
+    EXPECT_TRUE(it == list.end());
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 1}));
+    EXPECT_EQ(list.back(), 1);
+    list.erase(list.begin());
+    list.erase(list.begin());
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.size(), (size_t) 0);
+}
+
+TEST(LList, splice_whole_list) {
+    LList<int> batch{3, 4};
+    LList<int> list{1, 5};
+    int * moved = &batch.front();
+    auto pos = list.begin();
+    ++pos;
+    list.splice(pos, batch);
+    EXPECT_TRUE(batch.empty());
+    EXPECT_EQ(batch.size(), (size_t) 0);
+    EXPECT_EQ(list.size(), (size_t) 4);
+    EXPECT_EQ(contents(list), (std::vector<int>{1, 3, 4, 5}));
+    // Nodes are relinked, not reallocated.
+    EXPECT_EQ(moved, &*++list.begin());
+    batch.push_back(7);
+    list.splice(list.end(), batch);
+    list.splice(list.begin(), batch);
+    EXPECT_EQ(list.back(), 7);
+    EXPECT_EQ(list.front(), 1);
+}
+
+TEST(LList, splice_ranges_and_single_elements) {
+    LList<int> source{1, 2, 3, 4, 5};
+    LList<int> target{10};
+    auto first = source.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    target.splice(target.begin(), source, first, last, 2);
+    EXPECT_EQ(contents(target), (std::vector<int>{2, 3, 10}));
+    EXPECT_EQ(contents(source), (std::vector<int>{1, 4, 5}));
+    target.splice(target.end(), source, ++source.begin(), source.end());
+    EXPECT_EQ(contents(target), (std::vector<int>{2, 3, 10, 4, 5}));
+    EXPECT_EQ(source.size(), (size_t) 1);
+    target.splice(target.end(), source, source.begin());
+    EXPECT_TRUE(source.empty());
+    EXPECT_EQ(target.size(), (size_t) 6);
+    EXPECT_EQ(target.back(), 1);
+    // Reordering within one list.
+    target.splice(target.begin(), target, ++target.begin());
+    EXPECT_EQ(contents(target), (std::vector<int>{3, 2, 10, 4, 5, 1}));
+}
+
+TEST(LList, clear_destroys_every_node) {
+    // Own counter, LeakingCanary's is left off zero by the destructor test.
+    struct Counted {
+        int & alive;
+        explicit Counted(int & _alive) : alive(_alive) { alive++; }
+        Counted(const Counted & other) : alive(other.alive) { alive++; }
+        ~Counted() { alive--; }
+    };
+    int alive = 0;
+    {
+        LList<Counted> list;
+        for(int i = 0; i < 10; i++) list.emplace_back(alive);
+        EXPECT_EQ(alive, 10);
+        list.clear();
+        EXPECT_EQ(alive, 0);
+        list.emplace_back(alive);
+    }
+    EXPECT_EQ(alive, 0);
+}
@@ -0,0 +1,230 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#define LOGGING_ASYNC
+#define LOGGING_DEFERRED
+#define LOGGING_FLIGHT_RECORDER
+#define LOGGING_FLIGHT_RECORDS 4
+#define LOGGING_MIN_LEVEL INFO
+#include "logging/logging.hpp"
+#include "logging/deferred_decoder.hpp"
+#include "logging/stats_log.hpp"
+
+TEST(Logging, synchronous_output) {
+    testing::internal::CaptureStdout();
+    Logging::Info("value %d", 42);
+    Logging::Warning("plain");
+    fflush(stdout);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "[INFO] value 42\r\n[WARN] plain\r\n");
+}
+
+TEST(Logging, runtime_message_without_arguments) {
+    std::string message = "not a literal 100%";
+    testing::internal::CaptureStdout();
+    Logging::Error(message.c_str());
+    Logging::StartAsync(Logging::Overflow::BLOCK);
+    Logging::Info(message.c_str());
+    message.assign(message.size(), 'x');
+    Logging::StopAsync();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(),
+              "[ERROR] not a literal 100%\r\n[INFO] not a literal 100%\r\n");
+}
+
+TEST(Logging, async_output_in_order) {
+    testing::internal::CaptureStdout();
+    Logging::StartAsync(Logging::Overflow::BLOCK);
+    for (int i = 0; i < 3; ++i) {
+        Logging::Warning("%d %s %.1f", i, "str", 0.5);
+    }
+    Logging::Error("done");
+    Logging::StopAsync();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(),
+              "[WARN] 0 str 0.5\r\n[WARN] 1 str 0.5\r\n[WARN] 2 str 0.5\r\n[ERROR] done\r\n");
+}
+
+TEST(Logging, async_copies_strings) {
+    testing::internal::CaptureStdout();
+    Logging::StartAsync(Logging::Overflow::BLOCK);
+    {
+        std::string temporary = "short lived";
+        Logging::Info("%s!", temporary.c_str());
+        temporary.assign(temporary.size(), 'x');
+    }
+    Logging::StopAsync();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "[INFO] short lived!\r\n");
+}
+
+TEST(Logging, async_prints_caller_pointer) {
+    char unterminated[4] = {'a', 'b', 'c', 'd'};
+    char expected[64];
+    snprintf(expected, sizeof(expected), "[INFO] %p\r\n", static_cast<const void *>(unterminated));
+    testing::internal::CaptureStdout();
+    Logging::StartAsync(Logging::Overflow::BLOCK);
+    Logging::Info("%p", static_cast<const void *>(unterminated));
+    Logging::StopAsync();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), expected);
+}
+
+TEST(Logging, async_truncates_long_strings) {
+    testing::internal::CaptureStdout();
+    Logging::StartAsync(Logging::Overflow::BLOCK);
+    std::string long_string(1000, 'a');
+    Logging::Info("%s|%s|%d", long_string.c_str(), "b", 7);
+    Logging::StopAsync();
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_EQ(output.rfind("[INFO] aaa", 0), 0u);
+    // the first string takes the room left, later ones keep at least their terminator
+    EXPECT_NE(output.find("a||7\r\n"), std::string::npos);
+    EXPECT_LT(output.size(), (size_t) LOGGING_ASYNC_ARG_BYTES + 32);
+}
+
+TEST(Logging, async_drop_counts) {
+    size_t dropped_before = Logging::DroppedMessages();
+    testing::internal::CaptureStdout();
+    Logging::StartAsync(Logging::Overflow::DROP);
+    for (int i = 0; i < 20 * LOGGING_ASYNC_QUEUE_SIZE; ++i) {
+        Logging::Info("%d", i);
+    }
+    Logging::StopAsync();
+    std::string output = testing::internal::GetCapturedStdout();
+    size_t lines = 0;
+    for (char c : output) lines += c == '\n';
+    EXPECT_EQ(lines + Logging::DroppedMessages() - dropped_before, (size_t) 20 * LOGGING_ASYNC_QUEUE_SIZE);
+}
+
+static_assert(!Logging::Enabled(Logging::Level::DEBUG));
+static_assert(Logging::Enabled(Logging::Level::INFO));
+
+TEST(Logging, below_min_level_not_evaluated) {
+    int evaluated = 0;
+    testing::internal::CaptureStdout();
+    LOG_DEBUG("%d", ++evaluated);
+    Logging::Debug("%d", evaluated);
+    LOG_INFO("%d", ++evaluated);
+    fflush(stdout);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "[INFO] 1\r\n");
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST(Logging, deferred_round_trip) {
+    FILE *stream = tmpfile();
+    ASSERT_NE(stream, nullptr);
+    Logging::StartDeferred(stream);
+    const char *name = "sensor";
+    for (int i = 0; i < 2; ++i) {
+        Logging::Info("%s[%d] = %.2f (%5u, %#x, %c)", name, i, 1.5f * i, 42u, 255, 'z');
+    }
+    Logging::Warning("%lld %hd %-4s| %*d %%", (long long)-5, (short)-2, "ab", 3, 7);
+    Logging::Error("raw 100%");
+    char unterminated[4] = {'a', 'b', 'c', 'd'};
+    Logging::Info("at %p", static_cast<const void *>(unterminated));
+    Logging::StopDeferred();
+    char pointer_line[64];
+    snprintf(pointer_line, sizeof(pointer_line), "[INFO] at %p\r\n", static_cast<const void *>(unterminated));
+
+    std::vector<unsigned char> input;
+    rewind(stream);
+    for (int c; (c = fgetc(stream)) != EOF;) input.push_back(static_cast<unsigned char>(c));
+    fclose(stream);
+
+    std::string output;
+    EXPECT_TRUE(DeferredDecoder::Decode(input, output));
+    EXPECT_EQ(output,
+              "[INFO] sensor[0] = 0.00 (   42, 0xff, z)\r\n"
+              "[INFO] sensor[1] = 1.50 (   42, 0xff, z)\r\n"
+              "[WARN] -5 -2 ab  |   7 %\r\n"
+              "[ERROR] raw 100%\r\n" + std::string(pointer_line));
+
+    input.resize(input.size() - 3);
+    output.clear();
+    EXPECT_FALSE(DeferredDecoder::Decode(input, output));
+    EXPECT_EQ(output.rfind("[ERROR]"), output.size() - std::string("[ERROR] raw 100%\r\n").size());
+}
+
+namespace {
+
+ContainerStats sample_stats() {
+    ContainerStats stats;
+    stats.size = 3;
+    stats.capacity = 8;
+    stats.high_water = 5;
+    stats.pushes = 7;
+    stats.pops = 4;
+    return stats;
+}
+
+const char *const sample_stats_lines =
+    "[INFO] ring: size=3 capacity=8 high_water=5 pushes=7 pops=4 overwrites=0 drops=0"
+    " allocations=0 deallocations=0\r\n"
+    "[INFO] {\"name\":\"ring\",\"size\":3,\"capacity\":8,\"high_water\":5,\"pushes\":7,\"pops\":4,"
+    "\"overwrites\":0,\"drops\":0,\"allocations\":0,\"deallocations\":0}\r\n";
+
+}
+
+TEST(Logging, container_stats) {
+    testing::internal::CaptureStdout();
+    LogStats("ring", sample_stats());
+    LogStats("ring", sample_stats(), StatsFormat::JSON);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), sample_stats_lines);
+}
+
+TEST(Logging, async_container_stats_not_truncated) {
+    ContainerStats stats;
+    stats.size = stats.capacity = stats.high_water = SIZE_MAX;
+    stats.pushes = stats.pops = stats.overwrites = stats.drops = stats.allocations = stats.deallocations = UINT64_MAX;
+    const std::string name(stats_name_max, 'n');
+    char text[512];
+    char json[512];
+    stats.format_text(text, sizeof(text), name.c_str());
+    stats.format_json(json, sizeof(json), name.c_str());
+
+    testing::internal::CaptureStdout();
+    Logging::StartAsync(Logging::Overflow::BLOCK);
+    LogStats("ring", sample_stats());
+    LogStats("ring", sample_stats(), StatsFormat::JSON);
+    LogStats(name.c_str(), stats);
+    LogStats(name.c_str(), stats, StatsFormat::JSON);
+    Logging::StopAsync();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(),
+              sample_stats_lines + std::string("[INFO] ") + text + "\r\n[INFO] " + json + "\r\n");
+}
+
+TEST(Logging, flight_recorder_keeps_last_messages) {
+    const std::string path = testing::TempDir() + "flight_recorder_" + std::to_string(getpid());
+    unlink(path.c_str());
+    testing::internal::CaptureStdout();
+    Logging::StartFlightRecorder(path.c_str());
+    for (int i = 0; i < 6; ++i) Logging::Warning("event %d", i);
+    const std::string long_message(LOGGING_FLIGHT_RECORD_BYTES, 'x');
+    Logging::Error("%s", long_message.c_str());
+    Logging::StopFlightRecorder();
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+
+    auto recorder = Logging::FlightRecorder::open(path.c_str());
+    std::vector<std::string> messages;
+    recorder.for_each([&messages](const Logging::FlightRecord &record) { messages.emplace_back(record.text); });
+    EXPECT_EQ(messages, (std::vector<std::string>{"[WARN] event 3", "[WARN] event 4", "[WARN] event 5",
+                                                  "[ERROR] " + long_message.substr(0, LOGGING_FLIGHT_RECORD_BYTES - 9)}));
+    unlink(path.c_str());
+}
@@ -0,0 +1,97 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "mirrored_ringbuffer.hpp"
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+TEST(MirroredRingbuffer, capacity_rounds_to_pages) {
+    MirroredRingbuffer<char> ring(100);
+    EXPECT_EQ(ring.capacity() % (size_t)sysconf(_SC_PAGESIZE), (size_t) 0);
+    EXPECT_GE(ring.capacity(), (size_t) 100);
+    struct Odd { char bytes[12]; };
+    MirroredRingbuffer<Odd> odd(1);
+    EXPECT_EQ(odd.capacity() * sizeof(Odd) % (size_t)sysconf(_SC_PAGESIZE), (size_t) 0);
+}
+
+TEST(MirroredRingbuffer, push_front_pop) {
+    MirroredRingbuffer<int> ring(16);
+    EXPECT_TRUE(ring.empty());
+    for(int i = 0; i < 5; ++i) ring.push_back(i);
+    EXPECT_EQ(ring.size(), (size_t) 5);
+    EXPECT_EQ(ring.front(), 0);
+    EXPECT_EQ(ring.back(), 4);
+    ring.pop_front();
+    EXPECT_EQ(ring.front(), 1);
+    EXPECT_EQ(ring[3], 4);
+}
+
+TEST(MirroredRingbuffer, contiguous_across_wrap) {
+    MirroredRingbuffer<char> ring(1);
+    const size_t capacity = ring.capacity();
+    std::string filler(capacity - 3, 'x');
+    ring.push_back(std::span<const char>(filler.data(), filler.size()));
+    ring.consume(filler.size());
+    const char message[] = "straddling the end";
+    ring.push_back(std::span<const char>(message, sizeof(message)));
+    std::span<char> contents = ring.read_span();
+    ASSERT_EQ(contents.size(), sizeof(message));
+    EXPECT_EQ(std::memcmp(contents.data(), message, sizeof(message)), 0);
+    // The same bytes are visible through the first mapping.
+    EXPECT_EQ(&ring[3] - &ring[0], 3);
+    EXPECT_EQ(ring[5], message[5]);
+}
+
+TEST(MirroredRingbuffer, overwrites_oldest_when_full) {
+    MirroredRingbuffer<int> ring(1);
+    const size_t capacity = ring.capacity();
+    for(size_t i = 0; i < capacity + 3; ++i) ring.push_back((int)i);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.front(), 3);
+    EXPECT_EQ(ring.back(), (int)(capacity + 2));
+    std::span<int> contents = ring.read_span();
+    EXPECT_EQ(contents.size(), capacity);
+    for(size_t i = 0; i < capacity; ++i) EXPECT_EQ(contents[i], (int)(i + 3));
+}
+
+TEST(MirroredRingbuffer, write_span_and_commit) {
+    MirroredRingbuffer<int> ring(1);
+    ring.push_back(std::span<const int>(std::vector<int>(ring.capacity() - 2, 0)));
+    ring.consume(ring.size());
+    std::span<int> free = ring.write_span();
+    EXPECT_EQ(free.size(), ring.capacity());
+    std::iota(free.begin(), free.begin() + 6, 10);
+    ring.commit(6);
+    EXPECT_EQ(ring.size(), (size_t) 6);
+    EXPECT_EQ(ring.front(), 10);
+    EXPECT_EQ(ring.back(), 15);
+}
+
+TEST(MirroredRingbuffer, move) {
+    MirroredRingbuffer<int> ring(8);
+    ring.push_back(7);
+    MirroredRingbuffer<int> other(std::move(ring));
+    EXPECT_EQ(other.front(), 7);
+    EXPECT_EQ(ring.capacity(), (size_t) 0);
+    ring = std::move(other);
+    EXPECT_EQ(ring.front(), 7);
+}
@@ -0,0 +1,81 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "mpmc_list_queue.hpp"
+
+TEST(MpmcListQueue, push_pop_behaviour) {
+    MpmcListQueue<int> queue;
+    int value{0};
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    for(int i = 0; i < 1000; ++i) queue.push(i);
+    EXPECT_FALSE(queue.empty());
+    for(int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(MpmcListQueue, destructor_releases_items) {
+    auto shared = std::make_shared<int>(3);
+    {
+        MpmcListQueue<std::shared_ptr<int>> queue;
+        for(int i = 0; i < 5; ++i) queue.push(shared);
+        std::shared_ptr<int> item;
+        EXPECT_TRUE(queue.try_pop(item));
+        item.reset();
+        EXPECT_EQ(shared.use_count(), 5);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(MpmcListQueue, many_producers_many_consumers) {
+    constexpr int threads = 4;
+    constexpr int per_thread = 20000;
+    MpmcListQueue<std::unique_ptr<int>> queue;
+    std::atomic<long> sum{0};
+    std::atomic<int> popped{0};
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t) {
+        workers.emplace_back([&queue] {
+            for(int i = 1; i <= per_thread; ++i) queue.push(std::make_unique<int>(i));
+        });
+        workers.emplace_back([&queue, &sum, &popped] {
+            std::unique_ptr<int> item;
+            long local{0};
+            while(popped.load(std::memory_order_relaxed) < threads * per_thread) {
+                if(queue.try_pop(item)) {
+                    local += *item;
+                    popped++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sum += local;
+        });
+    }
+    for(auto & worker : workers) worker.join();
+    EXPECT_EQ(sum.load(), (long) threads * per_thread * (per_thread + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
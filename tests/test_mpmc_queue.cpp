@@ -0,0 +1,88 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "mpmc_queue.hpp"
+
+TEST(MpmcQueue, push_pop_behaviour) {
+    MpmcQueue<int, 4> queue;
+    int value{0};
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    for(int i = 0; i < 4; ++i) EXPECT_TRUE(queue.try_push(i));
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), (size_t) 4);
+    for(int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(MpmcQueue, round_and_round) {
+    MpmcQueue<int, 2> queue;
+    int value{0};
+    for(int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+}
+
+TEST(MpmcQueue, blocking_push_pop) {
+    MpmcQueue<int, 2> queue;
+    constexpr int count = 10000;
+    std::thread producer([&queue] {
+        for(int i = 0; i < count; ++i) queue.push(i);
+    });
+    int value{0};
+    for(int i = 0; i < count; ++i) {
+        queue.pop(value);
+        EXPECT_EQ(value, i);
+    }
+    producer.join();
+}
+
+TEST(MpmcQueue, many_producers_many_consumers) {
+    constexpr int threads = 4;
+    constexpr int per_thread = 20000;
+    MpmcQueue<int, 64> queue;
+    std::atomic<long> sum{0};
+    std::vector<std::thread> workers;
+    for(int t = 0; t < threads; ++t) {
+        workers.emplace_back([&queue] {
+            for(int i = 1; i <= per_thread; ++i) queue.push(i);
+        });
+        workers.emplace_back([&queue, &sum] {
+            int value{0};
+            long local{0};
+            for(int i = 0; i < per_thread; ++i) {
+                queue.pop(value);
+                local += value;
+            }
+            sum += local;
+        });
+    }
+    for(auto & worker : workers) worker.join();
+    EXPECT_EQ(sum.load(), (long) threads * per_thread * (per_thread + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
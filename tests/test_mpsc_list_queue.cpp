@@ -0,0 +1,76 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "mpsc_list_queue.hpp"
+
+TEST(MpscListQueue, push_pop_behaviour) {
+    MpscListQueue<int> queue;
+    int value{0};
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    for(int i = 0; i < 100; ++i) queue.push(i);
+    for(int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscListQueue, move_only_items_and_destructor) {
+    auto shared = std::make_shared<int>(3);
+    {
+        MpscListQueue<std::unique_ptr<int>> queue;
+        queue.emplace(new int(1));
+        queue.push(std::make_unique<int>(2));
+        std::unique_ptr<int> item;
+        EXPECT_TRUE(queue.try_pop(item));
+        EXPECT_EQ(*item, 1);
+        MpscListQueue<std::shared_ptr<int>> leftovers;
+        leftovers.push(shared);
+        leftovers.push(shared);
+        EXPECT_EQ(shared.use_count(), 3);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(MpscListQueue, many_producers_keep_their_order) {
+    constexpr int producers = 4;
+    constexpr int per_producer = 20000;
+    MpscListQueue<std::pair<int, int>> queue;
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for(int i = 0; i < per_producer; ++i) queue.emplace(p, i);
+        });
+    }
+    std::vector<int> next(producers, 0);
+    std::pair<int, int> item;
+    bool ordered = true;
+    for(int received = 0; received < producers * per_producer; ) {
+        if( ! queue.try_pop(item) ) { std::this_thread::yield(); continue; }
+        ordered = ordered && item.second == next[item.first]++;
+        received++;
+    }
+    for(auto & thread : threads) thread.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,85 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <new>
+#include <type_traits>
+#define USE_ITERATORS
+#include "llist.hpp"
+#include "node_pool.hpp"
+
+// A copy could not free what the original allocated, so there are none.
+static_assert( ! std::is_copy_constructible_v<PoolAllocator<int, 4>>);
+static_assert( ! std::is_constructible_v<PoolAllocator<int, 4>, const PoolAllocator<long, 4> &>);
+static_assert( ! std::is_copy_constructible_v<SlabAllocator<int>>);
+static_assert( ! std::is_constructible_v<SlabAllocator<int>, const SlabAllocator<long> &>);
+
+TEST(PoolAllocator, reuses_freed_slots) {
+    PoolAllocator<long, 2> pool;
+    long * first = pool.allocate(1);
+    long * second = pool.allocate(1);
+    EXPECT_NE(first, second);
+    EXPECT_THROW(pool.allocate(1), std::bad_alloc);
+    pool.deallocate(first, 1);
+    EXPECT_EQ(pool.allocate(1), first);
+}
+
+TEST(PoolAllocator, llist_steady_state) {
+    LList<int, PoolAllocator<int, 4>> list;
+    for(int round = 0; round < 100; ++round) {
+        for(int i = 0; i < 4; ++i) list.push_back(i);
+        for(int i = 0; i < 4; ++i) {
+            EXPECT_EQ(list.front(), i);
+            list.pop_front();
+        }
+    }
+    EXPECT_TRUE(list.empty());
+}
+
+TEST(PoolAllocator, llist_exhausted) {
+    LList<int, PoolAllocator<int, 3>> list{1, 2, 3};
+    EXPECT_THROW(list.push_front(0), std::bad_alloc);
+    list.pop_back();
+    list.push_front(0);
+    int expected{0};
+    for(auto value : list) EXPECT_EQ(value, expected++);
+}
+
+TEST(SlabAllocator, grows_by_slabs) {
+    LList<int, SlabAllocator<int, 8>> list;
+    for(int i = 0; i < 20; ++i) list.push_back(i);
+    EXPECT_EQ(list.get_allocator().slab_count(), (size_t) 3);
+    int expected{0};
+    for(auto value : list) EXPECT_EQ(value, expected++);
+    list.clear();
+    for(int i = 0; i < 20; ++i) list.push_front(i);
+    EXPECT_EQ(list.get_allocator().slab_count(), (size_t) 3);
+    EXPECT_EQ(list.front(), 19);
+    EXPECT_EQ(list.back(), 0);
+}
+
+TEST(PoolAllocator, llist_move_between_pools) {
+    LList<int, PoolAllocator<int, 4>> list{1, 2, 3};
+    LList<int, PoolAllocator<int, 4>> moved(std::move(list));
+    EXPECT_TRUE(list.empty());
+    int expected{1};
+    for(auto value : moved) EXPECT_EQ(value, expected++);
+    list.push_back(4);
+    EXPECT_EQ(list.front(), 4);
+}
@@ -0,0 +1,106 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "notifying_ringbuffer.hpp"
+
+// Returns once the consumer is blocked, so the next push has to wake it.
+template<class Ring>
+static void wait_until_sleeping(const Ring & ring) {
+    while( ! ring.sleeping() ) std::this_thread::yield();
+}
+
+TEST(NotifyingRingbuffer, wait_returns_when_data_is_there) {
+    NotifyingRingbuffer<int, 8> ring;
+    EXPECT_TRUE(ring.try_push(1));
+    EXPECT_TRUE(ring.try_push(2));
+    EXPECT_EQ(ring.wait(), 2u);
+    std::vector<int> drained;
+    EXPECT_EQ(ring.drain([&drained](int value) { drained.push_back(value); }), 2u);
+    EXPECT_EQ(drained, (std::vector<int>{1, 2}));
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.notifications(), 0u);
+}
+
+TEST(NotifyingRingbuffer, wakes_sleeping_consumer) {
+    NotifyingRingbuffer<int, 8> ring;
+    std::atomic<bool> woken{false};
+    std::thread consumer([&] {
+        ring.wait();
+        woken = true;
+    });
+    wait_until_sleeping(ring);
+    EXPECT_FALSE(woken);
+    EXPECT_TRUE(ring.try_push(7));
+    consumer.join();
+    EXPECT_TRUE(woken);
+    int value{0};
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_EQ(ring.notifications(), 1u);
+}
+
+TEST(NotifyingRingbuffer, watermark_and_flush) {
+    NotifyingRingbuffer<int, 16> ring(4);
+    std::atomic<size_t> available{0};
+    std::thread consumer([&] { available = ring.wait(); });
+    wait_until_sleeping(ring);
+    for(int i = 0; i < 3; ++i) EXPECT_TRUE(ring.try_push(i));
+    // Still below the watermark: wait() cannot return and nobody was woken.
+    EXPECT_TRUE(ring.sleeping());
+    EXPECT_EQ(available, 0u);
+    EXPECT_EQ(ring.notifications(), 0u);
+    EXPECT_TRUE(ring.try_push(3));
+    consumer.join();
+    EXPECT_EQ(available, 4u);
+    EXPECT_EQ(ring.drain([](int) {}), 4u);
+
+    std::thread flushed([&] { available = ring.wait(); });
+    wait_until_sleeping(ring);
+    EXPECT_TRUE(ring.try_push(4));
+    ring.flush();
+    flushed.join();
+    EXPECT_EQ(available, 1u);
+    EXPECT_EQ(ring.notifications(), 2u);
+}
+
+TEST(NotifyingRingbuffer, two_threads_batches) {
+    constexpr int count = 100000;
+    NotifyingRingbuffer<int, 256> ring(32);
+    std::thread producer([&ring] {
+        for(int i = 0; i < count; ++i) {
+            while( ! ring.try_push(i) ) std::this_thread::yield();
+            if(i % 64 == 0) std::this_thread::yield();
+        }
+        ring.flush();
+    });
+    int expected = 0;
+    bool ordered = true;
+    while(expected < count) {
+        ring.wait();
+        ring.drain([&](int value) { ordered = ordered && value == expected++; });
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    // One wake-up per batch at most, never one per element.
+    EXPECT_LE(ring.notifications(), (uint64_t)count / 32 + 1);
+}
@@ -0,0 +1,93 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "persistent_ringbuffer.hpp"
+
+struct Event {
+    uint32_t id;
+    uint32_t value;
+};
+
+class PersistentRingbufferTest : public testing::Test {
+protected:
+    std::string path = testing::TempDir() + "persistent_ringbuffer_" + std::to_string(getpid());
+    void SetUp() override { unlink(path.c_str()); }
+    void TearDown() override { unlink(path.c_str()); }
+};
+
+TEST_F(PersistentRingbufferTest, contents_survive_reopen) {
+    {
+        auto ring = PersistentRingbuffer<Event, 8>::open(path.c_str());
+        EXPECT_TRUE(ring.empty());
+        for(uint32_t i = 0; i < 3; ++i) ring.push_back({i, i * 10});
+    }
+    auto ring = PersistentRingbuffer<Event, 8>::open(path.c_str());
+    ASSERT_EQ(ring.size(), 3u);
+    EXPECT_EQ(ring.front().id, 0u);
+    EXPECT_EQ(ring.back().value, 20u);
+    ring.pop_front();
+    EXPECT_EQ(ring[0].id, 1u);
+}
+
+TEST_F(PersistentRingbufferTest, overwrites_oldest) {
+    auto ring = PersistentRingbuffer<Event, 4>::open(path.c_str());
+    for(uint32_t i = 0; i < 10; ++i) ring.push_back({i, 0});
+    EXPECT_EQ(ring.size(), 4u);
+    EXPECT_EQ(ring.total_pushed(), 10u);
+    std::vector<uint32_t> ids;
+    ring.for_each([&ids](const Event & event) { ids.push_back(event.id); });
+    EXPECT_EQ(ids, (std::vector<uint32_t>{6, 7, 8, 9}));
+    ring.clear();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(PersistentRingbufferTest, survives_process_death) {
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0) {
+        auto ring = PersistentRingbuffer<Event, 16>::open(path.c_str());
+        for(uint32_t i = 0; i < 20; ++i) ring.push_back({i, 1});
+        _exit(0); // no destructors, no munmap
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    auto ring = PersistentRingbuffer<Event, 16>::open(path.c_str());
+    ASSERT_EQ(ring.size(), 16u);
+    EXPECT_EQ(ring.front().id, 4u);
+    EXPECT_EQ(ring.back().id, 19u);
+}
+
+TEST_F(PersistentRingbufferTest, rejects_other_layout) {
+    { auto ring = PersistentRingbuffer<Event, 8>::open(path.c_str()); }
+    EXPECT_THROW((PersistentRingbuffer<Event, 16>::open(path.c_str())), std::system_error);
+    EXPECT_THROW((PersistentRingbuffer<uint32_t, 16>::open(path.c_str())), std::system_error);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.write("XXXX", 4);
+    }
+    EXPECT_THROW((PersistentRingbuffer<Event, 8>::open(path.c_str())), std::system_error);
+}
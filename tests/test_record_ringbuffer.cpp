@@ -0,0 +1,137 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include "record_ringbuffer.hpp"
+
+static std::span<const std::byte> bytes(std::string_view text) {
+    return std::as_bytes(std::span(text.data(), text.size()));
+}
+
+static std::string_view text(std::span<const std::byte> record) {
+    return {reinterpret_cast<const char *>(record.data()), record.size()};
+}
+
+TEST(RecordRingbuffer, push_peek_release) {
+    RecordRingbuffer<64> ring;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(ring.peek().data(), nullptr);
+    EXPECT_TRUE(ring.push(bytes("hello")));
+    EXPECT_TRUE(ring.push(bytes("")));
+    EXPECT_TRUE(ring.push(bytes("a longer record")));
+    EXPECT_EQ(ring.used(), 16u + 8u + 24u);
+    EXPECT_EQ(text(ring.peek()), "hello");
+    ring.release();
+    std::span<const std::byte> empty = ring.peek();
+    EXPECT_NE(empty.data(), nullptr);
+    EXPECT_EQ(empty.size(), 0u);
+    ring.release();
+    EXPECT_EQ(text(ring.peek()), "a longer record");
+    ring.release();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RecordRingbuffer, reserve_commit_in_place) {
+    RecordRingbuffer<64> ring;
+    std::span<std::byte> record = ring.reserve(16);
+    ASSERT_EQ(record.size(), 16u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(record.data()) % RecordRingbuffer<64>::record_alignment, 0u);
+    EXPECT_TRUE(ring.empty()); // not visible before commit
+    const uint64_t value = 0x0123456789abcdef;
+    memcpy(record.data(), &value, sizeof(value));
+    ring.commit(sizeof(value));
+    std::span<const std::byte> read = ring.peek();
+    ASSERT_EQ(read.size(), sizeof(value));
+    EXPECT_EQ(*reinterpret_cast<const uint64_t *>(read.data()), value);
+    ring.release();
+}
+
+TEST(RecordRingbuffer, full_rejects) {
+    RecordRingbuffer<64> ring;
+    const std::string_view record = "0123456789abcdef01234"; // 32 bytes with header
+    EXPECT_EQ(RecordRingbuffer<64>::max_record_size(), 24u);
+    EXPECT_TRUE(ring.push(bytes(record)));
+    EXPECT_TRUE(ring.push(bytes(record)));
+    EXPECT_FALSE(ring.push(bytes("x")));
+    EXPECT_EQ(ring.reserve(0).data(), nullptr);
+    ring.release();
+    EXPECT_TRUE(ring.push(bytes("x")));
+}
+
+TEST(RecordRingbuffer, pads_at_wrap) {
+    RecordRingbuffer<64> ring;
+    EXPECT_TRUE(ring.push(bytes("0123456789abcdef")));    // 24 bytes
+    EXPECT_TRUE(ring.push(bytes("0123456789abcdef")));    // 48 bytes
+    ring.release();
+    ring.release();
+    // 16 bytes left before the end, the record goes to offset 0 behind padding
+    EXPECT_TRUE(ring.push(bytes("0123456789abcdefghij")));
+    EXPECT_EQ(ring.used(), 16u + 32u);
+    EXPECT_EQ(text(ring.peek()), "0123456789abcdefghij");
+    EXPECT_EQ(ring.used(), 32u);
+    ring.release();
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RecordRingbuffer, padding_counts_against_free_space) {
+    RecordRingbuffer<128> ring;
+    const std::string_view record = "0123456789abcdef01234567"; // 32 bytes with header
+    for(int i = 0; i < 3; ++i) EXPECT_TRUE(ring.push(bytes(record)));
+    ring.release();
+    // 64 bytes are free but 32 of them lie before the end, 32 bytes of padding plus 48 do not fit
+    EXPECT_FALSE(ring.push(bytes("0123456789abcdef0123456789abcdef01234567")));
+    EXPECT_TRUE(ring.push(bytes(record)));
+    EXPECT_EQ(ring.used(), 96u);
+}
+
+TEST(RecordRingbuffer, two_threads_keep_order) {
+    constexpr uint32_t count = 100000;
+    RecordRingbuffer<256, true> ring;
+    std::thread producer([&ring] {
+        for(uint32_t i = 0; i < count; ++i) {
+            const size_t length = sizeof(uint32_t) * (1 + i % 7);
+            std::span<std::byte> record;
+            while( ! (record = ring.reserve(length)).data() ) std::this_thread::yield();
+            for(size_t word = 0; word < length / sizeof(uint32_t); ++word) {
+                memcpy(record.data() + word * sizeof(uint32_t), &i, sizeof(i));
+            }
+            ring.commit();
+        }
+    });
+    bool ordered = true;
+    for(uint32_t i = 0; i < count; ++i) {
+        std::span<const std::byte> record;
+        while( ! (record = ring.peek()).data() ) std::this_thread::yield();
+        ordered = ordered && record.size() == sizeof(uint32_t) * (1 + i % 7);
+        for(size_t word = 0; word < record.size() / sizeof(uint32_t); ++word) {
+            uint32_t value;
+            memcpy(&value, record.data() + word * sizeof(uint32_t), sizeof(value));
+            ordered = ordered && value == i;
+        }
+        ring.release();
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}
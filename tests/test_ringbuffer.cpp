@@ -19,6 +19,16 @@ Containers. If not, see <https://www.gnu.org/licenses/>.
 #include <gtest/gtest.h>
 #define USE_ITERATORS
 #include "ringbuffer.hpp"
+#include <algorithm>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <vector>
+
+static_assert(std::random_access_iterator<Ringbuffer<int, 8>::iterator>);
+static_assert(std::random_access_iterator<Ringbuffer<int, 8>::const_iterator>);
+static_assert(std::ranges::random_access_range<Ringbuffer<int, 8>>);
+static_assert(std::ranges::random_access_range<const Ringbuffer<int, 8>>);
 
 TEST(Ringbuffer, RingIndex_operations) {
     Ringbuffer<size_t, 3>::Index idx(0);
@@ -138,6 +148,7 @@ TEST(Ringbuffer, indexing) {
 struct Leaky {
     static int counter;
     Leaky() { counter++; }
+    Leaky(const Leaky &) { counter++; }
     ~Leaky() { counter--; }
 };
 int Leaky::counter = 0;
@@ -170,3 +181,187 @@ TEST(Ringbuffer, zero_size) {
     Ringbuffer<int, 16> ring;
     EXPECT_EQ(ring.size(), (size_t) 0);
 }
+
+TEST(Ringbuffer, power_of_two_index) {
+    Ringbuffer<int, 8>::Index idx(0);
+    EXPECT_EQ((size_t)--idx, 7);
+    EXPECT_EQ((size_t)(idx + 3), 2);
+    EXPECT_EQ((size_t)(Ringbuffer<int, 8>::Index(1) - 3), 6);
+    Ringbuffer<int, 8> ring;
+    for(int i = 0; i < 20; ++i) ring.push_back(i);
+    EXPECT_EQ(ring.size(), (size_t) 7);
+    EXPECT_EQ(ring.front(), 13);
+    EXPECT_EQ(ring[-1], 19);
+}
+
+TEST(Ringbuffer, bulk_push_pop_across_wrap) {
+    Ringbuffer<int, 8> ring;
+    for(int i = 0; i < 5; ++i) ring.push_back(i);
+    for(int i = 0; i < 5; ++i) ring.pop_front();
+    const int in[]{0, 1, 2, 3, 4, 5};
+    ring.push_back(std::span<const int>(in));
+    EXPECT_EQ(ring.size(), (size_t) 6);
+    EXPECT_EQ(ring.read_segments().first.size(), (size_t) 3);
+    EXPECT_EQ(ring.read_segments().second.size(), (size_t) 3);
+    int out[8]{};
+    EXPECT_EQ(ring.pop_front_into(out), (size_t) 6);
+    for(int i = 0; i < 6; ++i) EXPECT_EQ(out[i], i);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(Ringbuffer, bulk_push_overwrites_oldest) {
+    Ringbuffer<int, 5> ring = {0, 1, 2};
+    const int in[]{3, 4, 5};
+    ring.push_back(std::span<const int>(in));
+    EXPECT_EQ(ring.size(), (size_t) 4);
+    EXPECT_EQ(ring.front(), 2);
+    EXPECT_EQ(ring.back(), 5);
+    const int many[]{10, 11, 12, 13, 14, 15};
+    ring.push_back(std::span<const int>(many));
+    EXPECT_EQ(ring.front(), 12);
+    EXPECT_EQ(ring.back(), 15);
+}
+
+TEST(Ringbuffer, pop_front_into_partial) {
+    Ringbuffer<int, 10> ring = {1, 2, 3, 4};
+    int out[2]{};
+    EXPECT_EQ(ring.pop_front_into(out), (size_t) 2);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(ring.front(), 3);
+}
+
+TEST(Ringbuffer, fill_write_segments_in_place) {
+    Ringbuffer<int, 6> ring;
+    for(int i = 0; i < 4; ++i) ring.push_back(i);
+    ring.pop_front();
+    ring.pop_front();
+    auto free = ring.write_segments();
+    EXPECT_EQ(free.size(), ring.capacity() - ring.size());
+    int value{4};
+    for(auto & slot : free.first) slot = value++;
+    for(auto & slot : free.second) slot = value++;
+    ring.commit(free.size());
+    EXPECT_TRUE(ring.full());
+    for(int i = 2; i < 7; ++i) {
+        EXPECT_EQ(ring.front(), i);
+        ring.pop_front();
+    }
+}
+
+TEST(Ringbuffer, constructs_only_pushed_items) {
+    {
+        Ringbuffer<Leaky, 8> ring;
+        EXPECT_EQ(Leaky::counter, 0);
+        ring.emplace_back();
+        ring.emplace_front();
+        EXPECT_EQ(Leaky::counter, 2);
+        ring.pop_back();
+        EXPECT_EQ(Leaky::counter, 1);
+        for(int i = 0; i < 20; i++) ring.emplace_back();
+        EXPECT_EQ(Leaky::counter, 7);
+    }
+    EXPECT_EQ(Leaky::counter, 0);
+}
+
+TEST(Ringbuffer, move_only_items) {
+    Ringbuffer<std::unique_ptr<int>, 4> ring;
+    for(int i = 0; i < 5; ++i) ring.push_back(std::make_unique<int>(i));
+    EXPECT_EQ(*ring.front(), 2);
+    auto first = std::move(ring.front());
+    ring.pop_front();
+    EXPECT_EQ(*first, 2);
+    ring.emplace_front(new int(7));
+    EXPECT_EQ(*ring.front(), 7);
+    EXPECT_EQ(*ring.back(), 4);
+}
+
+TEST(Ringbuffer, move_constructor_and_assignment) {
+    Ringbuffer<std::string, 4> ring;
+    ring.emplace_back(3, 'a');
+    ring.push_back(std::string("b"));
+    Ringbuffer<std::string, 4> moved(std::move(ring));
+    EXPECT_TRUE(ring.empty());
+    EXPECT_EQ(moved.front(), "aaa");
+    EXPECT_EQ(moved.back(), "b");
+    Ringbuffer<std::string, 4> assigned;
+    assigned.push_back("c");
+    assigned = std::move(moved);
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(assigned.size(), (size_t) 2);
+    EXPECT_EQ(assigned.front(), "aaa");
+}
+
+TEST(Ringbuffer, bulk_with_non_trivial_items) {
+    Ringbuffer<std::string, 4> ring;
+    const std::string in[]{"a", "b", "c", "d"};
+    ring.push_back(std::span<const std::string>(in));
+    EXPECT_EQ(ring.front(), "b");
+    std::string out[3];
+    EXPECT_EQ(ring.pop_front_into(out), (size_t) 3);
+    EXPECT_EQ(out[0], "b");
+    EXPECT_EQ(out[2], "d");
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(Ringbuffer, random_access_iterator_arithmetic) {
+    Ringbuffer<int, 6> ring;
+    for(int i = 0; i < 8; ++i) ring.push_back(i);
+    // contents 3..7, wrapped around the end of the storage
+    auto it = ring.begin();
+    EXPECT_EQ(ring.end() - it, 5);
+    EXPECT_EQ(it[4], 7);
+    EXPECT_EQ(*(it + 2), 5);
+    EXPECT_EQ(*(2 + it), 5);
+    it += 4;
+    EXPECT_EQ(*it, 7);
+    it -= 3;
+    EXPECT_EQ(*it--, 4);
+    EXPECT_EQ(*it, 3);
+    EXPECT_TRUE(ring.begin() < ring.end());
+    EXPECT_TRUE(ring.cbegin() == ring.begin());
+    Ringbuffer<int, 6>::const_iterator cit = ring.end();
+    EXPECT_EQ(cit - ring.cbegin(), 5);
+}
+
+TEST(Ringbuffer, reverse_and_const_iteration) {
+    Ringbuffer<int, 5> ring;
+    for(int i = 0; i < 6; ++i) ring.push_back(i);
+    std::vector<int> reversed(ring.rbegin(), ring.rend());
+    EXPECT_EQ(reversed, (std::vector<int>{5, 4, 3, 2}));
+    const auto & cring = ring;
+    int expected = 2;
+    for(const int & item : cring) EXPECT_EQ(item, expected++);
+    EXPECT_EQ(*cring.crbegin(), 5);
+}
+
+TEST(Ringbuffer, std_algorithms_across_wrap) {
+    Ringbuffer<int, 8> ring;
+    for(int i = 0; i < 5; ++i) ring.push_back(0);
+    for(int i = 0; i < 5; ++i) ring.pop_front();
+    for(int item : {5, 1, 4, 2, 7, 3, 6}) ring.push_back(item);
+    std::sort(ring.begin(), ring.end());
+    EXPECT_TRUE(std::is_sorted(ring.cbegin(), ring.cend()));
+    EXPECT_EQ(ring.front(), 1);
+    EXPECT_EQ(ring.back(), 7);
+    EXPECT_EQ(*std::lower_bound(ring.begin(), ring.end(), 4), 4);
+    std::ranges::reverse(ring);
+    EXPECT_EQ(ring.front(), 7);
+    auto odd = ring | std::views::filter([](int item) { return item % 2; });
+    EXPECT_EQ(std::ranges::distance(odd), 4);
+}
+
+TEST(Ringbuffer, for_each_segment) {
+    Ringbuffer<int, 6> ring;
+    for(int i = 0; i < 8; ++i) ring.push_back(i);
+    size_t calls = 0;
+    int sum = 0;
+    std::as_const(ring).for_each_segment([&](std::span<const int> segment) {
+        calls++;
+        for(int item : segment) sum += item;
+    });
+    EXPECT_EQ(calls, (size_t) 2);
+    EXPECT_EQ(sum, 3 + 4 + 5 + 6 + 7);
+    ring.for_each_segment([](std::span<int> segment) { std::ranges::fill(segment, 1); });
+    EXPECT_EQ(std::count(ring.begin(), ring.end(), 1), 5);
+}
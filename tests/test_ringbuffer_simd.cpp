@@ -0,0 +1,90 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "ringbuffer.hpp"
+#include "ringbuffer_simd.hpp"
+#include <cstdint>
+#include <random>
+
+// Contents wrap around the end of the storage and are long enough to run
+// through whole vectors as well as scalar tails in both segments.
+template<class T, size_t N>
+static void fill(Ringbuffer<T, N> & ring, size_t count, std::mt19937 & random) {
+    std::uniform_int_distribution<int> values(-1000, 1000);
+    for(size_t i = 0; i < N / 2 + 3; ++i) ring.push_back(T{});
+    for(size_t i = 0; i < N / 2 + 3; ++i) ring.pop_front();
+    for(size_t i = 0; i < count; ++i) ring.push_back(static_cast<T>(values(random)));
+}
+
+template<class T>
+static void compare_with_indexed_loop() {
+    std::mt19937 random(7);
+    for(size_t count : {(size_t) 1, (size_t) 5, (size_t) 37, (size_t) 200, (size_t) 254}) {
+        Ringbuffer<T, 255> ring;
+        fill(ring, count, random);
+        ASSERT_EQ(ring.size(), count);
+        const int size = static_cast<int>(count);
+        T min = ring[0], max = ring[0];
+        long long sum = 0;
+        for(int i = 0; i < size; ++i) {
+            min = std::min(min, ring[i]);
+            max = std::max(max, ring[i]);
+            sum += static_cast<long long>(ring[i]);
+        }
+        EXPECT_EQ(ringbuffer_simd::min(ring), min);
+        EXPECT_EQ(ringbuffer_simd::max(ring), max);
+        EXPECT_EQ(static_cast<long long>(ringbuffer_simd::sum(ring)), sum);
+
+        const T needle = ring[size - 1];
+        size_t first = 0, matches = 0;
+        while(ring[(int)first] != needle) first++;
+        for(int i = 0; i < size; ++i) matches += ring[i] == needle;
+        EXPECT_EQ(ringbuffer_simd::find(ring, needle), first);
+        EXPECT_EQ(ringbuffer_simd::count(ring, needle), matches);
+        EXPECT_EQ(ringbuffer_simd::find(ring, T(5000)), count);
+
+        size_t above = 0;
+        while(above < count && !(ring[(int)above] > T(900))) above++;
+        EXPECT_EQ(ringbuffer_simd::find_above(ring, T(900)), above);
+
+        const size_t window = std::min(count, (size_t) 50);
+        long long window_sum = 0;
+        for(size_t i = count - window; i < count; ++i) window_sum += static_cast<long long>(ring[(int)i]);
+        EXPECT_DOUBLE_EQ(ringbuffer_simd::moving_average(ring, 50), (double) window_sum / window);
+    }
+}
+
+TEST(RingbufferSimd, float_matches_scalar) { compare_with_indexed_loop<float>(); }
+TEST(RingbufferSimd, int16_matches_scalar) { compare_with_indexed_loop<int16_t>(); }
+TEST(RingbufferSimd, other_types_use_scalar_loops) { compare_with_indexed_loop<int>(); }
+
+TEST(RingbufferSimd, int16_sum_does_not_overflow) {
+    static Ringbuffer<int16_t, 1 << 18> ring;
+    for(int i = 0; i < (1 << 18) - 1; ++i) ring.push_back(INT16_MAX);
+    EXPECT_EQ(ringbuffer_simd::sum(ring), (long long) INT16_MAX * ((1 << 18) - 1));
+    EXPECT_EQ(ringbuffer_simd::max(ring), INT16_MAX);
+}
+
+TEST(RingbufferSimd, empty_ring) {
+    Ringbuffer<float, 16> ring;
+    EXPECT_EQ(ringbuffer_simd::find(ring, 1.0f), (size_t) 0);
+    EXPECT_EQ(ringbuffer_simd::count(ring, 1.0f), (size_t) 0);
+    EXPECT_EQ(ringbuffer_simd::sum(ring), 0.0f);
+    EXPECT_EQ(ringbuffer_simd::moving_average(ring, 4), 0.0);
+}
@@ -0,0 +1,151 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "shm_ringbuffer.hpp"
+#include <string>
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct Frame {
+    uint32_t sequence;
+    char payload[28];
+};
+
+// Unique per process so parallel test runs do not collide.
+std::string segment_name(const char * test) {
+    return "/ringbuffer_" + std::string(test) + "_" + std::to_string(getpid());
+}
+
+}
+
+TEST(ShmRingbuffer, attach_sees_pushed_items) {
+    const std::string name = segment_name("attach");
+    auto producer = ShmRingbuffer<Frame>::create(name.c_str(), 5);
+    auto consumer = ShmRingbuffer<Frame>::attach(name.c_str());
+    ShmRingbuffer<Frame>::unlink(name.c_str());
+    EXPECT_EQ(consumer.capacity(), (size_t) 8);
+    for(uint32_t i = 0; i < 8; ++i) EXPECT_TRUE(producer.try_push(Frame{i, "frame"}));
+    EXPECT_FALSE(producer.try_push(Frame{8, "full"}));
+    EXPECT_TRUE(consumer.full());
+    // Both sides map the segment at different addresses.
+    ASSERT_NE(consumer.front(), nullptr);
+    EXPECT_EQ(consumer.front()->sequence, (uint32_t) 0);
+    consumer.pop_front();
+    EXPECT_TRUE(producer.try_push(Frame{8, "wrapped"}));
+    Frame frame;
+    for(uint32_t i = 1; i <= 8; ++i) {
+        ASSERT_TRUE(consumer.try_pop(frame));
+        EXPECT_EQ(frame.sequence, i);
+    }
+    EXPECT_STREQ(frame.payload, "wrapped");
+    EXPECT_FALSE(consumer.try_pop(frame));
+}
+
+TEST(ShmRingbuffer, create_refuses_existing_segment) {
+    const std::string name = segment_name("exists");
+    auto ring = ShmRingbuffer<int>::create(name.c_str(), 4);
+    EXPECT_THROW(ShmRingbuffer<int>::create(name.c_str(), 4), std::system_error);
+    ShmRingbuffer<int>::unlink(name.c_str());
+}
+
+TEST(ShmRingbuffer, attach_validates_header) {
+    const std::string name = segment_name("header");
+    auto ring = ShmRingbuffer<int>::create(name.c_str(), 4);
+    EXPECT_THROW(ShmRingbuffer<Frame>::attach(name.c_str()), std::system_error);
+    EXPECT_NO_THROW(ShmRingbuffer<int>::attach(name.c_str()));
+    ShmRingbuffer<int>::unlink(name.c_str());
+    EXPECT_THROW(ShmRingbuffer<int>::attach(name.c_str()), std::system_error);
+}
+
+TEST(ShmRingbuffer, attach_rejects_oversized_capacity) {
+    const std::string name = segment_name("capacity");
+    auto ring = ShmRingbuffer<int>::create(name.c_str(), 4);
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void * map = mmap(nullptr, sizeof(ShmRingbuffer<int>::Header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(map, MAP_FAILED);
+    auto * header = static_cast<ShmRingbuffer<int>::Header *>(map);
+    // capacity * sizeof(int) wraps around to 0 and would pass a plain size check.
+    header->capacity = uint64_t(1) << 62;
+    EXPECT_THROW(ShmRingbuffer<int>::attach(name.c_str()), std::system_error);
+    header->capacity = uint64_t(1) << 32;
+    EXPECT_THROW(ShmRingbuffer<int>::attach(name.c_str()), std::system_error);
+    header->capacity = 4;
+    EXPECT_NO_THROW(ShmRingbuffer<int>::attach(name.c_str()));
+    munmap(map, sizeof(ShmRingbuffer<int>::Header));
+    ShmRingbuffer<int>::unlink(name.c_str());
+}
+
+TEST(ShmRingbuffer, blocking_between_processes) {
+    const std::string name = segment_name("fork");
+    auto consumer = ShmRingbuffer<uint32_t>::create(name.c_str(), 16);
+    // The mapping is inherited by the child, it is only used there.
+    auto producer = ShmRingbuffer<uint32_t>::attach(name.c_str());
+    ShmRingbuffer<uint32_t>::unlink(name.c_str());
+    constexpr uint32_t count = 20000;
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0) {
+        for(uint32_t i = 0; i < count; ++i) producer.push(i);
+        _exit(0);
+    }
+    uint32_t item = 0;
+    bool ordered = true;
+    for(uint32_t i = 0; i < count; ++i) {
+        consumer.pop(item);
+        ordered = ordered && item == i;
+    }
+    EXPECT_TRUE(ordered);
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_TRUE(consumer.empty());
+}
+
+TEST(ShmRingbuffer, try_push_wakes_blocked_pop) {
+    const std::string name = segment_name("try_push");
+    auto consumer = ShmRingbuffer<uint32_t>::create(name.c_str(), 16);
+    auto producer = ShmRingbuffer<uint32_t>::attach(name.c_str());
+    ShmRingbuffer<uint32_t>::unlink(name.c_str());
+    constexpr uint32_t count = 2000;
+    const pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if(child == 0) {
+        // Only the non-blocking side, with pauses so the consumer keeps falling asleep.
+        for(uint32_t i = 0; i < count; ++i) {
+            while( ! producer.try_push(i) ) sched_yield();
+            if(i % 8 == 0) usleep(50);
+        }
+        _exit(0);
+    }
+    uint32_t item = 0;
+    bool ordered = true;
+    for(uint32_t i = 0; i < count; ++i) {
+        consumer.pop(item);
+        ordered = ordered && item == i;
+    }
+    EXPECT_TRUE(ordered);
+    int status = 0;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
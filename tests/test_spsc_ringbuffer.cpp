@@ -0,0 +1,115 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include "spsc_ringbuffer.hpp"
+
+TEST(SpscRingbuffer, push_pop_behaviour) {
+    SpscRingbuffer<int, 4> ring;
+    int value{0};
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.try_pop(value));
+    EXPECT_TRUE(ring.try_push(1));
+    EXPECT_TRUE(ring.try_push(2));
+    EXPECT_EQ(ring.size(), (size_t) 2);
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SpscRingbuffer, full_does_not_overwrite) {
+    SpscRingbuffer<int, 4> ring;
+    for(int i = 0; i < 3; ++i) EXPECT_TRUE(ring.try_push(i));
+    EXPECT_TRUE(ring.full());
+    EXPECT_FALSE(ring.try_push(3));
+    int value{-1};
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_push(3));
+    for(int i = 1; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(SpscRingbuffer, front_pop_front) {
+    SpscRingbuffer<int, 3> ring;
+    EXPECT_EQ(ring.front(), nullptr);
+    for(int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+        ASSERT_NE(ring.front(), nullptr);
+        EXPECT_EQ(*ring.front(), i);
+        ring.pop_front();
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+TEST(SpscRingbuffer, pop_destroys_element) {
+    struct Resource {
+        std::shared_ptr<int> owned;
+        explicit Resource(std::shared_ptr<int> p) : owned(std::move(p)) {}
+    };
+    auto resource = std::make_shared<int>(1);
+    {
+        SpscRingbuffer<Resource, 4> ring;  // Resource has no default constructor
+        EXPECT_TRUE(ring.try_push(Resource(resource)));
+        EXPECT_TRUE(ring.try_push(Resource(resource)));
+        EXPECT_EQ(resource.use_count(), 3);
+        ASSERT_NE(ring.front(), nullptr);
+        ring.pop_front();
+        EXPECT_EQ(resource.use_count(), 2);
+    }
+    EXPECT_EQ(resource.use_count(), 1);
+}
+
+TEST(SpscRingbuffer, indices_on_separate_cache_lines) {
+    SpscRingbuffer<char, 8> ring;
+    EXPECT_EQ(alignof(decltype(ring)), cache_line_size);
+    EXPECT_GE(sizeof(ring), 3 * cache_line_size);
+}
+
+TEST(SpscRingbuffer, two_threads_keep_order) {
+    constexpr int count = 200000;
+    SpscRingbuffer<int, 64> ring;
+    std::thread producer([&ring] {
+        for(int i = 0; i < count; ++i) {
+            while( ! ring.try_push(i) ) std::this_thread::yield();
+        }
+    });
+    int expected{0};
+    int value{0};
+    bool ordered = true;
+    while(expected < count) {
+        if(ring.try_pop(value)) {
+            ordered = ordered && value == expected;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(ring.empty());
+}
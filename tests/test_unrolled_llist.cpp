@@ -0,0 +1,99 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#define USE_ITERATORS
+#include "unrolled_llist.hpp"
+#include "node_pool.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+template<class List>
+static std::vector<int> contents(const List & list) {
+    std::vector<int> result;
+    for(int value : list) result.push_back(value);
+    return result;
+}
+
+TEST(UnrolledLList, push_pop_both_ends_across_chunks) {
+    UnrolledLList<int, 4> list;
+    EXPECT_TRUE(list.empty());
+    for(int i = 0; i < 10; ++i) list.push_back(i);
+    for(int i = 1; i <= 5; ++i) list.push_front(-i);
+    EXPECT_EQ(list.size(), (size_t) 15);
+    EXPECT_EQ(list.front(), -5);
+    EXPECT_EQ(list.back(), 9);
+    std::vector<int> expected;
+    for(int i = -5; i < 10; ++i) expected.push_back(i);
+    EXPECT_EQ(contents(list), expected);
+    for(int i = 0; i < 7; ++i) list.pop_front();
+    for(int i = 0; i < 3; ++i) list.pop_back();
+    EXPECT_EQ(contents(list), (std::vector<int>{2, 3, 4, 5, 6}));
+    while( ! list.empty() ) list.pop_back();
+    EXPECT_EQ(list.size(), (size_t) 0);
+    list.push_front(1);
+    EXPECT_EQ(list.back(), 1);
+}
+
+TEST(UnrolledLList, references_stay_valid) {
+    UnrolledLList<int, 2> list;
+    int & first = list.emplace_back(1);
+    for(int i = 2; i < 20; ++i) list.push_back(i);
+    for(int i = 0; i < 20; ++i) list.push_front(-i);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(&first, &*std::next(list.begin(), 20));
+}
+
+TEST(UnrolledLList, bidirectional_iteration) {
+    UnrolledLList<int, 3> list{0, 1, 2, 3, 4, 5, 6};
+    auto it = list.begin();
+    for(int i = 0; i < 6; ++i) ++it;
+    EXPECT_EQ(*it, 6);
+    int expected = 6;
+    while(it != list.begin()) EXPECT_EQ(*--it, --expected);
+    EXPECT_EQ(expected, 0);
+    *list.begin() = 10;
+    EXPECT_EQ(list.front(), 10);
+}
+
+TEST(UnrolledLList, destroys_non_trivial_items) {
+    auto item = std::make_shared<int>(1);
+    {
+        UnrolledLList<std::shared_ptr<int>, 4> list;
+        for(int i = 0; i < 9; ++i) list.push_back(item);
+        list.pop_front();
+        list.pop_back();
+        EXPECT_EQ(item.use_count(), 8);
+    }
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(UnrolledLList, move_and_pool_allocator) {
+    UnrolledLList<std::string, 4, PoolAllocator<std::string, 3>> list;
+    for(int i = 0; i < 12; ++i) list.push_back(std::to_string(i));
+    EXPECT_THROW(list.push_back("13"), std::bad_alloc);
+    UnrolledLList<std::string, 4, PoolAllocator<std::string, 3>> other(std::move(list));
+    EXPECT_EQ(other.size(), (size_t) 12);
+    EXPECT_EQ(other.back(), "11");
+    UnrolledLList<int> plain{1, 2};
+    UnrolledLList<int> moved;
+    moved = std::move(plain);
+    EXPECT_TRUE(plain.empty());
+    EXPECT_EQ(contents(moved), (std::vector<int>{1, 2}));
+}
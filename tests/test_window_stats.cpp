@@ -0,0 +1,102 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include "window_stats.hpp"
+#include <algorithm>
+#include <deque>
+#include <random>
+#include <string>
+
+TEST(WindowStats, matches_recomputed_window) {
+    WindowStats<int, 16> stats;
+    std::deque<int> reference;
+    std::mt19937 random(3);
+    std::uniform_int_distribution<int> values(-100, 100);
+    for(int i = 0; i < 500; ++i) {
+        const int value = values(random);
+        stats.push(value);
+        reference.push_back(value);
+        if(reference.size() > 16) reference.pop_front();
+
+        ASSERT_EQ(stats.size(), reference.size());
+        long long sum = 0, sum_sq = 0;
+        for(int item : reference) { sum += item; sum_sq += (long long) item * item; }
+        EXPECT_EQ(stats.sum(), sum);
+        EXPECT_EQ(stats.sum_of_squares(), sum_sq);
+        EXPECT_EQ(stats.min(), *std::min_element(reference.begin(), reference.end()));
+        EXPECT_EQ(stats.max(), *std::max_element(reference.begin(), reference.end()));
+        const double mean = (double) sum / reference.size();
+        EXPECT_DOUBLE_EQ(stats.mean(), mean);
+        EXPECT_NEAR(stats.variance(), (double) sum_sq / reference.size() - mean * mean, 1e-9);
+    }
+    EXPECT_TRUE(stats.full());
+    EXPECT_EQ(stats.values().front(), reference.front());
+}
+
+TEST(WindowStats, duplicates_and_monotonic_input) {
+    WindowStats<double, 3> stats;
+    for(double value : {5.0, 5.0, 5.0, 1.0, 2.0, 3.0, 4.0}) stats.push(value);
+    EXPECT_EQ(stats.min(), 2.0);
+    EXPECT_EQ(stats.max(), 4.0);
+    EXPECT_DOUBLE_EQ(stats.mean(), 3.0);
+    EXPECT_NEAR(stats.variance(), 2.0 / 3.0, 1e-12);
+    for(double value : {9.0, 8.0, 7.0}) stats.push(value);
+    EXPECT_EQ(stats.min(), 7.0);
+    EXPECT_EQ(stats.max(), 9.0);
+    stats.clear();
+    EXPECT_TRUE(stats.empty());
+    stats.push(-1.0);
+    EXPECT_EQ(stats.max(), -1.0);
+}
+
+// Concatenation is associative but not commutative, so any mix-up of the
+// element order shows in the result.
+struct Concat {
+    using value_type = std::string;
+    static std::string identity() { return ""; }
+    static std::string lift(char value) { return std::string(1, value); }
+    static std::string combine(const std::string & older, const std::string & newer) { return older + newer; }
+};
+
+TEST(WindowAggregate, keeps_element_order) {
+    WindowAggregate<char, 4, Concat> window;
+    EXPECT_EQ(window.query(), "");
+    std::string pushed;
+    for(char c = 'a'; c <= 'z'; ++c) {
+        window.push(c);
+        pushed += c;
+        EXPECT_EQ(window.query(), pushed.substr(pushed.size() > 4 ? pushed.size() - 4 : 0));
+    }
+    window.pop();
+    EXPECT_EQ(window.query(), "xyz");
+    EXPECT_EQ(window.size(), (size_t) 3);
+}
+
+TEST(WindowAggregate, max_over_window) {
+    WindowAggregate<int, 5, MaxAggregate<int>> window;
+    std::deque<int> reference;
+    std::mt19937 random(11);
+    for(int i = 0; i < 200; ++i) {
+        const int value = (int) (random() % 1000);
+        window.push(value);
+        reference.push_back(value);
+        if(reference.size() > 5) reference.pop_front();
+        EXPECT_EQ(window.query(), *std::max_element(reference.begin(), reference.end()));
+    }
+}
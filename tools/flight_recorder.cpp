@@ -0,0 +1,66 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <containers/persistent_ringbuffer.hpp>
+
+/// Prints the elements of a PersistentRingbuffer file, oldest first: as text up
+/// to the first NUL, which suits Logging::StartFlightRecorder files, or with -x
+/// as hex bytes for any other element type.
+int main(int argc, char ** argv) {
+    const bool hex = argc == 3 && strcmp(argv[1], "-x") == 0;
+    if(argc != 2 && ! hex) {
+        fprintf(stderr, "usage: %s [-x] <flight recorder file>\n", argv[0]);
+        return 2;
+    }
+    const char * path = argv[argc - 1];
+    const int fd = open(path, O_RDONLY);
+    struct stat st;
+    if(fd < 0 || fstat(fd, &st) != 0) {
+        perror(path);
+        return 2;
+    }
+    const size_t bytes = (size_t)st.st_size;
+    void * map = bytes ? mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    const auto * header = static_cast<const PersistentRingbufferHeader *>(map);
+    if(map == MAP_FAILED || ! header->valid(bytes)) {
+        fprintf(stderr, "%s: not a ringbuffer file or damaged header\n", path);
+        return 1;
+    }
+    const unsigned char * data = static_cast<const unsigned char *>(map) + header->data_offset;
+    const uint64_t tail = header->tail.load();
+    for(uint64_t i = header->head.load(); i != tail; ++i) {
+        const unsigned char * element = data + (i % header->capacity) * header->element_size;
+        if(hex) {
+            for(uint64_t byte = 0; byte < header->element_size; ++byte) printf("%02x", element[byte]);
+            printf("\n");
+        } else {
+            printf("%.*s\n", (int)strnlen(reinterpret_cast<const char *>(element), header->element_size), element);
+        }
+    }
+    munmap(map, bytes);
+    return 0;
+}
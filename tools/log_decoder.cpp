@@ -0,0 +1,51 @@
+/*
+Copyright 2023, Martin Kopecky (martin.kopecky357@gmail.com)
+
+This file is part of Containers.
+
+Containers is free software: you can redistribute it and/or modify it under the terms of
+the GNU General Public License as published by the Free Software Foundation,
+either version 3 of the License, or (at your option) any later version.
+
+Containers is distributed in the hope that it will be useful, but WITHOUT ANY
+WARRANTY; without even the implied warranty of MERCHANTABILITY or
+FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+more details.
+
+You should have received a copy of the GNU General Public License along with
+Containers. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <logging/deferred_decoder.hpp>
+
+/// Prints a log written by Logging::StartDeferred as text.
+int main(int argc, char ** argv) {
+    if(argc != 2) {
+        fprintf(stderr, "usage: %s <deferred log file>\n", argv[0]);
+        return 2;
+    }
+    FILE * in = fopen(argv[1], "rb");
+    if( ! in ) {
+        perror(argv[1]);
+        return 2;
+    }
+    std::vector<unsigned char> input;
+    unsigned char buffer[4096];
+    for(size_t count; (count = fread(buffer, 1, sizeof(buffer), in)) > 0; ) {
+        input.insert(input.end(), buffer, buffer + count);
+    }
+    fclose(in);
+
+    std::string output;
+    const bool complete = DeferredDecoder::Decode(input, output);
+    fwrite(output.data(), 1, output.size(), stdout);
+    if( ! complete ) {
+        fprintf(stderr, "%s: malformed or truncated log\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}